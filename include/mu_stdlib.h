@@ -1,12 +1,24 @@
 #pragma once
 
+#include <algorithm>
 #include <atomic>
 #include <array>
 #include <cstdint>
 #include <future>
 #include <functional>
+#include <mutex>
+#include <new>
 #include <optional>
+#include <bit>
 #include <bitset>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
 
 #ifndef SPDLOG_FMT_EXTERNAL
 #define SPDLOG_FMT_EXTERNAL 1
@@ -76,6 +88,12 @@ namespace mu
 #undef LPSTR
 #endif // #if _WINDOWS_redefined
 
+#if defined(_MSC_VER)
+#define MU_NOINLINE __declspec(noinline)
+#else
+#define MU_NOINLINE __attribute__((noinline))
+#endif
+
 namespace mu
 {
 	template<typename E>
@@ -181,6 +199,41 @@ namespace mu
 #define MU_LEAF_THROW_EXCEPTION ::boost::leaf::leaf_detail::throw_with_loc{__FILE__, __LINE__, __FUNCTION__} + ::boost::leaf::exception
 #define MU_LEAF_LOG_ERROR(...)	((void)0)
 
+// Per call site log limiting (see mu::debug::log_limiter). The logger expression and arguments are only evaluated for
+// messages that get through.
+//
+//     MU_LOG_LIMITED(*l, warn, 5, 10, "slow frame {0}", n); // 5 a second, bursts of 10
+//     MU_LOG_SAMPLED(*l, debug, 100, "packet {0}", id);     // 1 in 100
+//     MU_LOG_ERROR("open {0} failed", path);                 // stderr logger, default limit
+#define MU_LOG_LIMITED(logger, lvl, per_second, burst, ...)                                                                                                                        \
+	do                                                                                                                                                                             \
+	{                                                                                                                                                                              \
+		static ::mu::debug::log_limiter mu_log_limiter(__FILE__, __LINE__, per_second, burst);                                                                                     \
+		if (mu_log_limiter.allow())                                                                                                                                                \
+		{                                                                                                                                                                          \
+			(logger).log(::spdlog::level::lvl, __VA_ARGS__);                                                                                                                       \
+		}                                                                                                                                                                          \
+	}                                                                                                                                                                              \
+	while (0)
+
+#define MU_LOG_SAMPLED(logger, lvl, every, ...)                                                                                                                                    \
+	do                                                                                                                                                                             \
+	{                                                                                                                                                                              \
+		static ::mu::debug::log_limiter mu_log_limiter(__FILE__, __LINE__, 0, 0, every);                                                                                           \
+		if (mu_log_limiter.allow())                                                                                                                                                \
+		{                                                                                                                                                                          \
+			(logger).log(::spdlog::level::lvl, __VA_ARGS__);                                                                                                                       \
+		}                                                                                                                                                                          \
+	}                                                                                                                                                                              \
+	while (0)
+
+#define MU_LOG_DEFAULT_LIMITED(logger, lvl, ...) MU_LOG_LIMITED(logger, lvl, ::mu::debug::log_limiter::default_per_second, ::mu::debug::log_limiter::default_burst, __VA_ARGS__)
+#define MU_LOG_CRITICAL(...)					 MU_LOG_DEFAULT_LIMITED(*::mu::debug::logger()->stderr_logger(), critical, __VA_ARGS__)
+#define MU_LOG_ERROR(...)						 MU_LOG_DEFAULT_LIMITED(*::mu::debug::logger()->stderr_logger(), err, __VA_ARGS__)
+#define MU_LOG_WARN(...)						 MU_LOG_DEFAULT_LIMITED(*::mu::debug::logger()->stderr_logger(), warn, __VA_ARGS__)
+#define MU_LOG_INFO(...)						 MU_LOG_DEFAULT_LIMITED(*::mu::debug::logger()->stdout_logger(), info, __VA_ARGS__)
+#define MU_LOG_DEBUG(...)						 MU_LOG_DEFAULT_LIMITED(*::mu::debug::logger()->stdout_logger(), debug, __VA_ARGS__)
+
 namespace mu
 {
 	template<typename T>
@@ -191,87 +244,262 @@ namespace mu
 	{
 		return f.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
 	}
+
+	// A small, dense index for the calling thread, handed back for reuse when the thread exits. Lets per-thread
+	// structures live in flat arrays instead of thread_local maps; indices only exceed the peak number of live
+	// threads if the registry couldn't allocate.
+	auto thread_index() noexcept -> uint32_t;
+
+	namespace details
+	{
+		// The CPU the calling thread is running on right now; it may have moved by the time the caller looks.
+		// Platforms without a cheap query hand out thread_index() instead, which still spreads threads apart.
+		auto current_cpu() noexcept -> uint32_t;
+		auto cpu_count() noexcept -> uint32_t;
+	} // namespace details
+
+	namespace time
+	{
+		auto get_now() noexcept -> int64_t;
+	} // namespace time
 } // namespace mu
 
 namespace mu
 {
 	namespace details
 	{
+		// Every accessor below follows the same shape: the constructor does one load of s_instance and only calls
+		// out of line while it is still null, so once initialized an access inlines to a load and a predicted branch.
+		// The out-of-line path keeps the function-local static, which serializes the first construction.
 		template<typename T>
 		class static_root_singleton
 		{
 		public:
 			auto operator->() noexcept -> T*
 			{
-				return s_instance;
+				return m_instance;
 			}
 
 			auto operator->() const noexcept -> const T*
 			{
-				return s_instance;
+				return m_instance;
 			}
 
 			auto operator*() noexcept -> T&
 			{
-				return *s_instance;
+				return *m_instance;
 			}
 
 			auto operator*() const noexcept -> const T&
 			{
-				return *s_instance;
+				return *m_instance;
 			}
 
 			static_root_singleton() noexcept
+				: m_instance(s_instance.load(std::memory_order_acquire))
 			{
-				static bool static_init = []() -> bool
+				if (m_instance == nullptr) [[unlikely]]
 				{
-					s_instance = new (&s_instance_memory[0]) T();
-					std::atexit(destroy);
-					return true;
-				}();
+					m_instance = initialize();
+				}
 			}
 
 		protected:
 			static void destroy() noexcept
 			{
-				if (s_instance)
+				if (T* instance = s_instance.exchange(nullptr))
 				{
-					s_instance->~T();
-					s_instance = nullptr;
+					instance->~T();
 				}
 			}
 
 		private:
-			static inline uint64_t s_instance_memory[1 + (sizeof(T) / sizeof(uint64_t))];
-			static inline T*	   s_instance = nullptr;
+			MU_NOINLINE static auto initialize() noexcept -> T*
+			{
+				[[maybe_unused]] static bool static_init = []() -> bool
+				{
+					s_instance.store(new (&s_instance_memory[0]) T(), std::memory_order_release);
+					std::atexit(destroy);
+					return true;
+				}();
+				return s_instance.load(std::memory_order_acquire);
+			}
+
+			T* m_instance;
+
+			alignas(T) static inline uint64_t s_instance_memory[1 + (sizeof(T) / sizeof(uint64_t))];
+			static inline std::atomic<T*> s_instance{nullptr};
 		};
 
-		template<size_t POOL_COUNT>
+		// Cleanup callbacks run in reverse order of registration. Entries are a function pointer and a context, stored
+		// in segments that double in size: the first lives inline, later ones are allocated once each, on demand,
+		// by whichever push first needs them. push() is lock-free and never allocates per entry.
 		class singleton_cleanup_list
 		{
 		public:
-			using cleanup_func = std::function<void()>;
+			using cleanup_func = void (*)(void* context) noexcept;
+
+			singleton_cleanup_list() noexcept
+			{
+				m_segments[0].store(m_inline, std::memory_order_relaxed);
+			}
+
+			singleton_cleanup_list(const singleton_cleanup_list&)					 = delete;
+			auto operator=(const singleton_cleanup_list&) -> singleton_cleanup_list& = delete;
+
+			// False only if a new segment couldn't be allocated; that entry is then never cleaned up.
+			auto push(cleanup_func f, void* context = nullptr) noexcept -> bool
+			{
+				const size_t index	 = m_count.fetch_add(1, std::memory_order_relaxed);
+				const size_t segment = segment_of(index);
+				if (segment >= segment_count)
+				{
+					return false;
+				}
+
+				entry* entries = m_segments[segment].load(std::memory_order_acquire);
+				if (entries == nullptr)
+				{
+					entries = allocate_segment(segment);
+					if (entries == nullptr)
+					{
+						return false;
+					}
+				}
+
+				entry& e  = entries[index + first_segment_size - (first_segment_size << segment)];
+				e.context = context;
+				e.func.store(f, std::memory_order_release);
+				return true;
+			}
 
-			void push(cleanup_func f) noexcept
+			auto size() const noexcept -> size_t
 			{
-				s_cleanup_funcs[s_cleanup_index.fetch_add(1)] = f;
+				return m_count.load(std::memory_order_relaxed);
 			}
 
 			~singleton_cleanup_list() noexcept
 			{
-				for (auto i = s_cleanup_index.load(); i > 0; --i)
+				// Anything registered from inside a cleanup lands past the end and is left alone.
+				for (size_t i = m_count.load(); i > 0; --i)
+				{
+					const size_t index	 = i - 1;
+					const size_t segment = segment_of(index);
+					entry*		 entries = segment < segment_count ? m_segments[segment].load(std::memory_order_acquire) : nullptr;
+					if (entries == nullptr)
+					{
+						continue;
+					}
+
+					entry& e = entries[index + first_segment_size - (first_segment_size << segment)];
+					if (cleanup_func f = e.func.exchange(nullptr, std::memory_order_acquire))
+					{
+						f(e.context);
+					}
+				}
+
+				for (size_t segment = 1; segment < segment_count; ++segment)
 				{
-					s_cleanup_funcs[i - 1]();
+					delete[] m_segments[segment].load(std::memory_order_relaxed);
 				}
-				s_cleanup_index.store(0);
 			}
 
 		private:
-			std::array<cleanup_func, POOL_COUNT> s_cleanup_funcs;
-			std::atomic_size_t					 s_cleanup_index = 0;
+			struct entry
+			{
+				std::atomic<cleanup_func> func{nullptr}; // Published last, so a half-written entry is skipped
+				void*					  context = nullptr;
+			};
+
+			static constexpr size_t first_segment_bits = 6;
+			static constexpr size_t first_segment_size = size_t(1) << first_segment_bits;
+			static constexpr size_t segment_count	   = 32; // 64 * (2^32 - 1) entries in all
+
+			// Segment k holds indices [64 * (2^k - 1), 64 * (2^(k+1) - 1)).
+			static constexpr auto segment_of(const size_t index) noexcept -> size_t
+			{
+				return static_cast<size_t>(std::bit_width((index >> first_segment_bits) + 1)) - 1;
+			}
+
+			auto allocate_segment(const size_t segment) noexcept -> entry*
+			{
+				entry* fresh = new (std::nothrow) entry[first_segment_size << segment];
+				if (fresh == nullptr)
+				{
+					return nullptr;
+				}
+
+				entry* expected = nullptr;
+				if (!m_segments[segment].compare_exchange_strong(expected, fresh, std::memory_order_acq_rel, std::memory_order_acquire))
+				{
+					delete[] fresh; // Another push got there first
+					return expected;
+				}
+				return fresh;
+			}
+
+			std::atomic_size_t	m_count{0};
+			std::atomic<entry*> m_segments[segment_count] = {};
+			entry				m_inline[first_segment_size];
+		};
+
+		using singleton_cleanup_root = details::static_root_singleton<details::singleton_cleanup_list>;
+
+		// Readable name of T, taken from the compiler's signature for this function.
+		template<typename T>
+		constexpr auto type_name() noexcept -> std::string_view
+		{
+#if defined(_MSC_VER) && !defined(__clang__)
+			constexpr std::string_view signature = __FUNCSIG__;
+			constexpr size_t		   begin	 = signature.find("type_name<") + 10;
+			constexpr size_t		   end		 = signature.rfind(">(void)");
+#else
+			constexpr std::string_view signature = __PRETTY_FUNCTION__;
+			constexpr size_t		   begin	 = signature.find("T = ") + 4;
+			constexpr size_t		   end		 = signature.find_first_of(";]", begin);
+#endif
+			return signature.substr(begin, end - begin);
+		}
+
+		// One vertex of the singleton dependency graph. Every mu::singleton / virtual_singleton in the program
+		// registers its node during static initialization, so the whole graph is known before anything is built.
+		struct singleton_node
+		{
+			std::string_view name;
+			std::string_view group; // From T::singleton_group, for mu::singletons::prewarm
+			void (*construct)() noexcept;
+			auto (*dependencies)() noexcept -> std::span<singleton_node* const>;
+			std::atomic<int64_t> construct_ticks{-1}; // The factory's own cost, dependencies excluded; -1 until built
 		};
 
-		using singleton_cleanup_root = details::static_root_singleton<details::singleton_cleanup_list<1024>>;
+		template<typename T>
+		constexpr auto group_of() noexcept -> std::string_view
+		{
+			if constexpr (requires { T::singleton_group; })
+			{
+				return T::singleton_group;
+			}
+			else
+			{
+				return {};
+			}
+		}
+
+		auto register_singleton(singleton_node* node) noexcept -> bool;
+		auto registered_singletons() noexcept -> std::vector<singleton_node*>;
+
+		template<typename T>
+		inline auto node_of() noexcept -> singleton_node*
+		{
+			if constexpr (requires { T::node(); })
+			{
+				return &T::node();
+			}
+			else
+			{
+				return nullptr; // Not part of the graph (e.g. thread-local); still constructed lazily
+			}
+		}
 
 		template<typename... T_DEPS>
 		struct singleton_dependencies
@@ -295,10 +523,105 @@ namespace mu
 					update_dependencies_impl<T_DEPS...>();
 				}
 			}
+
+			static inline auto nodes() noexcept -> std::span<singleton_node* const>
+			{
+				static const std::array<singleton_node*, sizeof...(T_DEPS)> list{node_of<T_DEPS>()...};
+				return list;
+			}
 		};
 
-		template<typename T, typename... T_DEPS>
-		struct singleton_factory
+		// Carves singleton storage out of the arena (see mu::singletons::configure_arena). Isolated blocks are
+		// cache-line aligned and padded to whole lines, and grow down from the top of the region while packed ones
+		// grow up from the bottom, so the two never share a line. Returns nullptr once the arena is full.
+		auto singleton_arena_allocate(size_t size, size_t alignment, bool isolated) noexcept -> void*;
+		auto singleton_arena_contains(const void* p) noexcept -> bool;
+	} // namespace details
+
+	// Where a singleton's storage comes from. A type opts in by declaring
+	//     static constexpr mu::singleton_placement singleton_placement = mu::singleton_placement::isolated;
+	enum class singleton_placement : int
+	{
+		heap = 0, // operator new, as for any other object
+		packed,	  // Read-mostly: packed next to the other packed singletons in the arena
+		isolated  // Written often or contended: cache lines of its own in the arena
+	};
+
+	// Allocator policies for mu::allocated_singleton. Anything with the same two static functions can be used.
+	struct heap_singleton_allocator
+	{
+		static inline auto allocate(const size_t size, const size_t alignment) noexcept -> void*
+		{
+			return ::operator new(size, std::align_val_t(alignment), std::nothrow);
+		}
+
+		static inline void deallocate(void* p, const size_t, const size_t alignment) noexcept
+		{
+			::operator delete(p, std::align_val_t(alignment));
+		}
+	};
+
+	// Falls back to the heap, still honouring the cache-line isolation, when the arena is full.
+	template<singleton_placement T_PLACEMENT>
+	struct singleton_arena_allocator
+	{
+		static constexpr size_t cache_line = 64;
+		static constexpr bool	isolated   = T_PLACEMENT == singleton_placement::isolated;
+
+		static inline auto allocate(const size_t size, const size_t alignment) noexcept -> void*
+		{
+			if (void* p = details::singleton_arena_allocate(size, alignment, isolated))
+			{
+				return p;
+			}
+			return isolated ? heap_singleton_allocator::allocate((size + cache_line - 1) & ~(cache_line - 1), std::max(alignment, cache_line))
+							: heap_singleton_allocator::allocate(size, alignment);
+		}
+
+		static inline void deallocate(void* p, const size_t size, const size_t alignment) noexcept
+		{
+			// Arena blocks live as long as the process.
+			if (!details::singleton_arena_contains(p))
+			{
+				heap_singleton_allocator::deallocate(p, size, isolated ? std::max(alignment, cache_line) : alignment);
+			}
+		}
+	};
+
+	namespace singletons
+	{
+		struct arena_info
+		{
+			const void* base		  = nullptr;
+			size_t		capacity	  = 0;
+			size_t		packed_used	  = 0;
+			size_t		isolated_used = 0;
+			bool		huge_pages	  = false; // Backed by explicit huge pages (or, on Linux, madvised for THP)
+		};
+
+		// Sizes the region placed singletons are carved from, and whether to try huge pages for it. The region
+		// is reserved when the first placed singleton is built; after that this returns false and changes nothing.
+		auto configure_arena(size_t capacity, bool huge_pages) noexcept -> bool;
+		auto get_arena_info() noexcept -> arena_info;
+	} // namespace singletons
+
+	namespace details
+	{
+		template<typename T>
+		constexpr auto placement_of() noexcept -> singleton_placement
+		{
+			if constexpr (requires { T::singleton_placement; })
+			{
+				return T::singleton_placement;
+			}
+			else
+			{
+				return singleton_placement::heap;
+			}
+		}
+
+		template<typename T, typename T_ALLOCATOR, typename... T_DEPS>
+		struct allocated_singleton_factory
 		{
 			static inline auto create() noexcept -> T*
 			{
@@ -306,7 +629,62 @@ namespace mu
 				{
 					singleton_dependencies<T_DEPS...>::update();
 				}
-				return new T();
+				void* storage = T_ALLOCATOR::allocate(sizeof(T), alignof(T));
+				return storage != nullptr ? new (storage) T() : nullptr;
+			}
+
+			static inline void destroy(T* instance) noexcept
+			{
+				if (instance != nullptr)
+				{
+					instance->~T();
+					T_ALLOCATOR::deallocate(instance, sizeof(T), alignof(T));
+				}
+			}
+
+			static inline auto dependencies() noexcept -> std::span<singleton_node* const>
+			{
+				return singleton_dependencies<T_DEPS...>::nodes();
+			}
+		};
+
+		template<typename T, typename... T_DEPS>
+		struct singleton_factory
+		{
+			static constexpr singleton_placement placement = placement_of<T>();
+			using placed_factory						   = allocated_singleton_factory<T, singleton_arena_allocator<placement>, T_DEPS...>;
+
+			static inline auto create() noexcept -> T*
+			{
+				if constexpr (placement != singleton_placement::heap)
+				{
+					return placed_factory::create();
+				}
+				else
+				{
+					if constexpr (sizeof...(T_DEPS) > 0)
+					{
+						singleton_dependencies<T_DEPS...>::update();
+					}
+					return new T();
+				}
+			}
+
+			static inline void destroy(T* instance) noexcept
+			{
+				if constexpr (placement != singleton_placement::heap)
+				{
+					placed_factory::destroy(instance);
+				}
+				else
+				{
+					delete instance;
+				}
+			}
+
+			static inline auto dependencies() noexcept -> std::span<singleton_node* const>
+			{
+				return singleton_dependencies<T_DEPS...>::nodes();
 			}
 		};
 
@@ -314,6 +692,12 @@ namespace mu
 		struct virtual_singleton_factory
 		{
 			static auto create() noexcept -> T*;
+			static auto dependencies() noexcept -> std::span<singleton_node* const>;
+
+			static inline void destroy(T* instance) noexcept
+			{
+				delete instance;
+			}
 		};
 	} // namespace details
 
@@ -326,6 +710,12 @@ namespace mu
 			auto virtual_singleton_factory<T>::create() noexcept -> T*                                                                                                             \
 			{                                                                                                                                                                      \
 				return new T_DERIVED;                                                                                                                                              \
+			}                                                                                                                                                                      \
+                                                                                                                                                                                   \
+			template<>                                                                                                                                                             \
+			auto virtual_singleton_factory<T>::dependencies() noexcept -> std::span<singleton_node* const>                                                                         \
+			{                                                                                                                                                                      \
+				return {};                                                                                                                                                         \
 			}                                                                                                                                                                      \
 		}                                                                                                                                                                          \
 	}                                                                                                                                                                              \
@@ -341,6 +731,12 @@ namespace mu
 			{                                                                                                                                                                      \
 				singleton_dependencies<__VA_ARGS__>::update();                                                                                                                     \
 				return new T_DERIVED;                                                                                                                                              \
+			}                                                                                                                                                                      \
+                                                                                                                                                                                   \
+			template<>                                                                                                                                                             \
+			auto virtual_singleton_factory<T>::dependencies() noexcept -> std::span<singleton_node* const>                                                                         \
+			{                                                                                                                                                                      \
+				return singleton_dependencies<__VA_ARGS__>::nodes();                                                                                                               \
 			}                                                                                                                                                                      \
 		}                                                                                                                                                                          \
 	}                                                                                                                                                                              \
@@ -357,51 +753,89 @@ namespace mu
 
 			auto operator->() noexcept -> T*
 			{
-				return s_instance;
+				return m_instance;
 			}
 
 			auto operator->() const noexcept -> const T*
 			{
-				return s_instance;
+				return m_instance;
 			}
 
 			auto operator*() noexcept -> T&
 			{
-				return *s_instance;
+				return *m_instance;
 			}
 
 			auto operator*() const noexcept -> const T&
 			{
-				return *s_instance;
+				return *m_instance;
 			}
 
 			auto get() noexcept -> T*
 			{
-				return s_instance;
+				return m_instance;
 			}
 
 			auto get() const noexcept -> const T*
 			{
-				return s_instance;
+				return m_instance;
 			}
 
 			singleton_base() noexcept
+				: m_instance(s_instance.load(std::memory_order_acquire))
+			{
+				if (m_instance == nullptr) [[unlikely]]
+				{
+					m_instance = initialize();
+				}
+			}
+
+			static auto node() noexcept -> singleton_node&
+			{
+				static singleton_node n{
+					type_name<T>(),
+					group_of<T>(),
+					[]() noexcept
+					{
+						initialize();
+					},
+					&factory::dependencies};
+				return n;
+			}
+
+		private:
+			MU_NOINLINE static auto initialize() noexcept -> T*
 			{
-				static bool static_init = []() -> bool
+				(void)s_registered;
+				[[maybe_unused]] static bool static_init = []() -> bool
 				{
-					s_instance = factory::create();
+					// Dependencies first, so the timing below is this singleton's own cost.
+					for (singleton_node* dependency : factory::dependencies())
+					{
+						if (dependency != nullptr)
+						{
+							dependency->construct();
+						}
+					}
+
+					const int64_t begin = time::get_now();
+					s_instance.store(factory::create(), std::memory_order_release);
+					node().construct_ticks.store(time::get_now() - begin, std::memory_order_relaxed);
+
 					singleton_cleanup_root()->push(
-						[]() -> void
+						[](void*) noexcept
 						{
-							delete s_instance;
-							s_instance = nullptr;
+							factory::destroy(s_instance.exchange(nullptr));
 						});
 					return true;
 				}();
+				return s_instance.load(std::memory_order_acquire);
 			}
 
-		private:
-			static inline T* s_instance;
+			T* m_instance;
+
+			static inline std::atomic<T*> s_instance{nullptr};
+			static inline const bool	  s_registered = register_singleton(&node());
 		};
 	} // namespace details
 
@@ -411,6 +845,350 @@ namespace mu
 	template<typename T, typename... T_DEPENDENCIES>
 	using virtual_singleton = details::singleton_base<T, details::virtual_singleton_factory<T>>;
 
+	// A singleton whose storage comes from T_ALLOCATOR, e.g. singleton_arena_allocator<singleton_placement::isolated>.
+	template<typename T, typename T_ALLOCATOR, typename... T_DEPENDENCIES>
+	using allocated_singleton = details::singleton_base<T, details::allocated_singleton_factory<T, T_ALLOCATOR, T_DEPENDENCIES...>>;
+
+	namespace details
+	{
+		template<typename T>
+		class per_cpu_shards
+		{
+		public:
+			struct alignas(64) shard
+			{
+				T value;
+			};
+
+			per_cpu_shards() noexcept
+				: m_count(std::max<uint32_t>(1, cpu_count()))
+				, m_shards(new (std::nothrow) shard[m_count])
+			{
+				if (m_shards == nullptr)
+				{
+					// Contended, but correct.
+					m_count	 = 1;
+					m_shards = &m_fallback;
+				}
+			}
+
+			~per_cpu_shards()
+			{
+				if (m_shards != &m_fallback)
+				{
+					delete[] m_shards;
+				}
+			}
+
+			per_cpu_shards(const per_cpu_shards&)					 = delete;
+			auto operator=(const per_cpu_shards&) -> per_cpu_shards& = delete;
+
+			inline auto local() noexcept -> T&
+			{
+				return m_shards[current_cpu() % m_count].value;
+			}
+
+			inline auto at(const uint32_t index) noexcept -> T&
+			{
+				return m_shards[index].value;
+			}
+
+			inline auto count() const noexcept -> uint32_t
+			{
+				return m_count;
+			}
+
+		private:
+			uint32_t m_count;
+			shard*	 m_shards;
+			shard	 m_fallback;
+		};
+	} // namespace details
+
+	// One instance of T per CPU, each on its own cache line, so updates from different cores never touch the same
+	// line. The calling thread's shard is picked by the CPU it is on at the time, and it can migrate (or be
+	// preempted by a thread that lands on the same CPU) mid-update, so T's members still need to be atomic; the
+	// win is that those atomics are almost never contended. Reads that need the whole value visit every shard:
+	//
+	//     struct counter { std::atomic<uint64_t> value{0}; };
+	//
+	//     mu::per_cpu_singleton<counter>()->value.fetch_add(1, std::memory_order_relaxed);
+	//     const uint64_t total = mu::per_cpu_singleton<counter>().accumulate(uint64_t(0), [](uint64_t sum, const counter& c) {
+	//         return sum + c.value.load(std::memory_order_relaxed);
+	//     });
+	template<typename T, typename... T_DEPENDENCIES>
+	class per_cpu_singleton
+	{
+	public:
+		using type			 = T;
+		using shards_type	 = details::per_cpu_shards<T>;
+		using singleton_type = singleton<shards_type, T_DEPENDENCIES...>;
+
+		per_cpu_singleton() noexcept
+			: m_shards(singleton_type().get())
+		{
+		}
+
+		auto operator->() noexcept -> T*
+		{
+			return &m_shards->local();
+		}
+
+		auto operator*() noexcept -> T&
+		{
+			return m_shards->local();
+		}
+
+		// The calling CPU's shard.
+		auto local() noexcept -> T&
+		{
+			return m_shards->local();
+		}
+
+		auto shard_count() const noexcept -> uint32_t
+		{
+			return m_shards->count();
+		}
+
+		// Visits every shard. Concurrent updates keep landing while this runs, so the result is a sum of
+		// per-shard snapshots rather than one consistent instant.
+		template<typename T_FUNC>
+		void for_each(T_FUNC&& func) noexcept(noexcept(func(std::declval<T&>())))
+		{
+			for (uint32_t i = 0; i < m_shards->count(); ++i)
+			{
+				func(m_shards->at(i));
+			}
+		}
+
+		template<typename T_RESULT, typename T_FUNC>
+		auto accumulate(T_RESULT init, T_FUNC&& func) -> T_RESULT
+		{
+			for (uint32_t i = 0; i < m_shards->count(); ++i)
+			{
+				init = func(std::move(init), static_cast<const T&>(m_shards->at(i)));
+			}
+			return init;
+		}
+
+	private:
+		shards_type* m_shards;
+	};
+
+	namespace details
+	{
+		// Epoch-based reclamation for swappable singletons. A reader publishes the global epoch it saw in its thread's
+		// slot for as long as it holds a pointer; a replaced instance is retired at a new epoch and freed once no slot
+		// holds anything older. Readers only ever store to their own slot.
+		static constexpr uint32_t epoch_slot_count = 256;
+
+		struct alignas(64) epoch_slot
+		{
+			std::atomic<uint64_t> epoch{0}; // 0 while the thread holds nothing
+		};
+
+		inline std::atomic<uint64_t> g_epoch{1};
+		inline epoch_slot			 g_epoch_slots[epoch_slot_count];
+		inline std::atomic<uint64_t> g_epoch_overflow_readers{0}; // Threads past epoch_slot_count, counted instead
+		inline thread_local uint32_t t_epoch_depth = 0;
+
+		inline void epoch_enter() noexcept
+		{
+			if (t_epoch_depth++ == 0)
+			{
+				const uint32_t index = thread_index();
+				if (index < epoch_slot_count)
+				{
+					g_epoch_slots[index].epoch.store(g_epoch.load(std::memory_order_relaxed), std::memory_order_relaxed);
+					// The slot must be visible before the caller loads the pointer it protects.
+					std::atomic_thread_fence(std::memory_order_seq_cst);
+				}
+				else
+				{
+					g_epoch_overflow_readers.fetch_add(1, std::memory_order_seq_cst);
+				}
+			}
+		}
+
+		inline void epoch_exit() noexcept
+		{
+			if (--t_epoch_depth == 0)
+			{
+				const uint32_t index = thread_index();
+				if (index < epoch_slot_count)
+				{
+					g_epoch_slots[index].epoch.store(0, std::memory_order_release);
+				}
+				else
+				{
+					g_epoch_overflow_readers.fetch_sub(1, std::memory_order_release);
+				}
+			}
+		}
+
+		// Takes ownership of p and frees it with deleter once every reader that could have seen it has left. Called
+		// after p has been unpublished.
+		void epoch_retire(void* p, void (*deleter)(void*) noexcept) noexcept;
+	} // namespace details
+
+	namespace singletons
+	{
+		// Frees whatever retired instances no reader can still see. Swaps already do this; it's for callers that
+		// want old instances gone without another swap.
+		void reclaim() noexcept;
+
+		// Blocks until every instance retired so far has been freed. Never call it while holding a swappable
+		// accessor: it would wait on itself.
+		void synchronize() noexcept;
+	} // namespace singletons
+
+	namespace details
+	{
+		// An accessor is also a read-side critical section: the instance it loaded stays alive until it goes out of
+		// scope, however many replace() calls happen meanwhile. Entering and leaving are a store and a fence on the
+		// thread's own cache line, so readers never wait on writers or on each other.
+		template<typename T, typename T_FACTORY>
+		class swappable_singleton_base
+		{
+		public:
+			using factory = T_FACTORY;
+			using type	  = T;
+
+			static_assert(placement_of<T>() == singleton_placement::heap, "swappable singletons are replaced with new/delete");
+
+			swappable_singleton_base() noexcept
+			{
+				epoch_enter();
+				m_instance = s_instance.load(std::memory_order_acquire);
+				if (m_instance == nullptr) [[unlikely]]
+				{
+					m_instance = initialize();
+				}
+			}
+
+			~swappable_singleton_base()
+			{
+				epoch_exit();
+			}
+
+			swappable_singleton_base(const swappable_singleton_base&)					 = delete;
+			auto operator=(const swappable_singleton_base&) -> swappable_singleton_base& = delete;
+
+			auto operator->() const noexcept -> T*
+			{
+				return m_instance;
+			}
+
+			auto operator*() const noexcept -> T&
+			{
+				return *m_instance;
+			}
+
+			auto get() const noexcept -> T*
+			{
+				return m_instance;
+			}
+
+			// Publishes next (which must come from new) in place of the current instance. Readers that already
+			// hold the old one keep using it; it is deleted once they've all let go.
+			static void replace(T* next) noexcept
+			{
+				initialize();
+				T* previous = s_instance.exchange(next, std::memory_order_acq_rel);
+				if (previous != nullptr)
+				{
+					epoch_retire(previous,
+								 [](void* p) noexcept
+								 {
+									 delete static_cast<T*>(p);
+								 });
+				}
+			}
+
+			template<typename T_IMPL = T, typename... T_ARGS>
+			static auto emplace(T_ARGS&&... args) noexcept -> bool
+			{
+				T* next = new (std::nothrow) T_IMPL(std::forward<T_ARGS>(args)...);
+				if (next == nullptr)
+				{
+					return false;
+				}
+				replace(next);
+				return true;
+			}
+
+			static auto node() noexcept -> singleton_node&
+			{
+				static singleton_node n{
+					type_name<T>(),
+					group_of<T>(),
+					[]() noexcept
+					{
+						initialize();
+					},
+					&factory::dependencies};
+				return n;
+			}
+
+		private:
+			MU_NOINLINE static auto initialize() noexcept -> T*
+			{
+				(void)s_registered;
+				[[maybe_unused]] static bool static_init = []() -> bool
+				{
+					for (singleton_node* dependency : factory::dependencies())
+					{
+						if (dependency != nullptr)
+						{
+							dependency->construct();
+						}
+					}
+
+					const int64_t begin = time::get_now();
+					s_instance.store(factory::create(), std::memory_order_release);
+					node().construct_ticks.store(time::get_now() - begin, std::memory_order_relaxed);
+
+					singleton_cleanup_root()->push(
+						[](void*) noexcept
+						{
+							// Retired like any replaced instance, so it's freed now only if no reader holds it. Static
+							// destruction shouldn't wait on threads that are still reading: what they hold leaks.
+							if (T* last = s_instance.exchange(nullptr, std::memory_order_acq_rel); last != nullptr)
+							{
+								epoch_retire(last,
+											 [](void* p) noexcept
+											 {
+												 delete static_cast<T*>(p);
+											 });
+							}
+							singletons::reclaim();
+						});
+					return true;
+				}();
+				return s_instance.load(std::memory_order_acquire);
+			}
+
+			T* m_instance;
+
+			static inline std::atomic<T*> s_instance{nullptr};
+			static inline const bool	  s_registered = register_singleton(&node());
+		};
+	} // namespace details
+
+	// A singleton that can be replaced at runtime:
+	//
+	//     mu::swappable_singleton<routing_table>()->route(request); // wait-free, whatever else is going on
+	//     mu::swappable_singleton<routing_table>::emplace(parsed);  // from the reload path
+	//
+	// Don't keep an accessor alive across long waits: the instances retired meanwhile can't be freed until it goes.
+	template<typename T, typename... T_DEPENDENCIES>
+	using swappable_singleton = details::swappable_singleton_base<T, details::singleton_factory<T, T_DEPENDENCIES...>>;
+
+	// As swappable_singleton, with the first instance built by MU_DEFINE_VIRTUAL_SINGLETON(_DEPS); later ones can be
+	// any implementation of T, e.g. swappable_virtual_singleton<router>::emplace<weighted_router>(weights).
+	template<typename T>
+	using swappable_virtual_singleton = details::swappable_singleton_base<T, details::virtual_singleton_factory<T>>;
+
 	template<typename T_SINGLETON>
 	class exported_singleton
 	{
@@ -420,46 +1198,63 @@ namespace mu
 
 		auto operator->() noexcept -> type*
 		{
-			return s_instance;
+			return m_instance;
 		}
 
 		auto operator->() const noexcept -> const type*
 		{
-			return s_instance;
+			return m_instance;
 		}
 
 		auto operator*() noexcept -> type&
 		{
-			return *s_instance;
+			return *m_instance;
 		}
 
 		auto operator*() const noexcept -> const type&
 		{
-			return *s_instance;
+			return *m_instance;
 		}
 
 		auto get() noexcept -> type*
 		{
-			return s_instance;
+			return m_instance;
 		}
 
 		auto get() const noexcept -> const type*
 		{
-			return s_instance;
+			return m_instance;
 		}
 
 		exported_singleton() noexcept
+			: m_instance(s_instance.load(std::memory_order_acquire))
 		{
-			static bool static_init = []() -> bool
+			if (m_instance == nullptr) [[unlikely]]
 			{
-				s_instance = get_instance();
+				m_instance = initialize();
+			}
+		}
+
+		static auto node() noexcept -> details::singleton_node&
+		{
+			return singleton_type::node();
+		}
+
+	private:
+		MU_NOINLINE static auto initialize() noexcept -> type*
+		{
+			[[maybe_unused]] static bool static_init = []() -> bool
+			{
+				s_instance.store(get_instance(), std::memory_order_release);
 				return true;
 			}();
+			return s_instance.load(std::memory_order_acquire);
 		}
 
-	private:
-		static inline type* s_instance;
-		static type*		get_instance() noexcept;
+		type* m_instance;
+
+		static inline std::atomic<type*> s_instance{nullptr};
+		static type*					 get_instance() noexcept;
 	};
 
 #define MU_EXPORT_SINGLETON(T)                                                                                                                                                     \
@@ -487,32 +1282,31 @@ namespace mu
 		public:
 			auto operator->() noexcept -> T*
 			{
-				return s_instance;
+				return m_instance;
 			}
 
 			auto operator->() const noexcept -> const T*
 			{
-				return s_instance;
+				return m_instance;
 			}
 
 			auto operator*() noexcept -> T&
 			{
-				return *s_instance;
+				return *m_instance;
 			}
 
 			auto operator*() const noexcept -> const T&
 			{
-				return *s_instance;
+				return *m_instance;
 			}
 
 			static_root_thread_local_singleton() noexcept
+				: m_instance(s_instance)
 			{
-				static bool static_init = []() -> bool
+				if (m_instance == nullptr) [[unlikely]]
 				{
-					s_instance = new (&s_instance_memory[0]) T();
-					std::atexit(destroy);
-					return true;
-				}();
+					m_instance = initialize();
+				}
 			}
 
 		protected:
@@ -526,11 +1320,34 @@ namespace mu
 			}
 
 		private:
-			static inline thread_local uint64_t s_instance_memory[1 + (sizeof(T) / sizeof(uint64_t))];
-			static inline thread_local T*		s_instance = nullptr;
+			// Builds this thread's instance and tears it down when the thread exits (for the main thread, during
+			// exit(), ahead of the process-wide singletons).
+			struct thread_owner
+			{
+				thread_owner() noexcept
+				{
+					s_instance = new (&s_instance_memory[0]) T();
+				}
+
+				~thread_owner()
+				{
+					destroy();
+				}
+			};
+
+			MU_NOINLINE static auto initialize() noexcept -> T*
+			{
+				static thread_local thread_owner owner;
+				return s_instance;
+			}
+
+			T* m_instance;
+
+			alignas(T) static inline thread_local uint64_t s_instance_memory[1 + (sizeof(T) / sizeof(uint64_t))];
+			static inline thread_local T* s_instance = nullptr;
 		};
 
-		using thread_local_singleton_cleanup_root = static_root_thread_local_singleton<singleton_cleanup_list<1024>>;
+		using thread_local_singleton_cleanup_root = static_root_thread_local_singleton<singleton_cleanup_list>;
 
 		template<typename T, typename T_FACTORY>
 		class thread_local_singleton_base
@@ -539,58 +1356,154 @@ namespace mu
 			using type = T;
 			auto operator->() noexcept -> T*
 			{
-				return s_instance;
+				return m_instance;
 			}
 
 			auto operator->() const noexcept -> const T*
 			{
-				return s_instance;
+				return m_instance;
 			}
 
 			auto operator*() noexcept -> T&
 			{
-				return *s_instance;
+				return *m_instance;
 			}
 
 			auto operator*() const noexcept -> const T&
 			{
-				return *s_instance;
+				return *m_instance;
+			}
+
+			auto get() noexcept -> T*
+			{
+				return m_instance;
+			}
+
+			auto get() const noexcept -> const T*
+			{
+				return m_instance;
+			}
+
+			thread_local_singleton_base() noexcept
+				: m_instance(s_instance)
+			{
+				if (m_instance == nullptr) [[unlikely]]
+				{
+					m_instance = initialize();
+				}
+			}
+
+			static inline thread_local T* s_instance = nullptr;
+
+		private:
+			MU_NOINLINE static auto initialize() noexcept -> T*
+			{
+				[[maybe_unused]] static thread_local bool static_init = []() -> bool
+				{
+					s_instance = T_FACTORY::create();
+					thread_local_singleton_cleanup_root()->push(
+						[](void*) noexcept
+						{
+							T_FACTORY::destroy(s_instance);
+							s_instance = nullptr;
+						});
+					return true;
+				}();
+				return s_instance;
+			}
+
+			T* m_instance;
+		};
+	} // namespace details
+
+	template<typename T, typename... T_DEPENDENCIES>
+	using thread_local_singleton = details::thread_local_singleton_base<T, details::singleton_factory<T, T_DEPENDENCIES...>>;
+
+	template<typename T, typename... T_DEPENDENCIES>
+	using thread_local_virtual_singleton = details::thread_local_singleton_base<T, details::virtual_singleton_factory<T>>;
+
+	namespace details
+	{
+		// Instances handed back by exiting threads, waiting for new ones. Threads come and go rarely enough that
+		// a mutex is fine here. Whatever is left at exit goes back through T_FACTORY, which made it.
+		template<typename T, size_t T_CAPACITY, typename T_FACTORY>
+		class recycle_pool
+		{
+		public:
+			auto pop() noexcept -> T*
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				return m_count > 0 ? m_items[--m_count] : nullptr;
+			}
+
+			auto push(T* instance) noexcept -> bool
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				if (m_count == T_CAPACITY)
+				{
+					return false;
+				}
+				m_items[m_count++] = instance;
+				return true;
 			}
 
-			auto get() noexcept -> T*
+			~recycle_pool() noexcept
 			{
-				return s_instance;
+				for (size_t i = 0; i < m_count; ++i)
+				{
+					T_FACTORY::destroy(m_items[i]);
+				}
 			}
 
-			auto get() const noexcept -> const T*
+		private:
+			std::mutex				   m_mutex;
+			std::array<T*, T_CAPACITY> m_items{};
+			size_t					   m_count = 0;
+		};
+
+		// Like singleton_factory, but a thread's instance outlives the thread: it goes into a pool of up to
+		// T_CAPACITY and the next thread to need one takes it instead of constructing a new one. If T has a
+		// recycle() member it's called on the way back out, e.g. to clear a scratch buffer but keep its capacity.
+		template<typename T, size_t T_CAPACITY, typename... T_DEPS>
+		struct recycling_singleton_factory
+		{
+			using factory = singleton_factory<T, T_DEPS...>;
+			using pool	  = static_root_singleton<recycle_pool<T, T_CAPACITY, factory>>;
+
+			static inline auto create() noexcept -> T*
 			{
-				return s_instance;
+				pool p;
+				if (T* instance = p.operator->() != nullptr ? p->pop() : nullptr)
+				{
+					if constexpr (requires(T& t) { t.recycle(); })
+					{
+						instance->recycle();
+					}
+					return instance;
+				}
+				return factory::create();
 			}
 
-			thread_local_singleton_base() noexcept
+			static inline void destroy(T* instance) noexcept
 			{
-				static thread_local bool static_init = []() -> bool
+				// The pool is gone once static destruction has started; threads exiting after that destroy outright.
+				// Either way it's the factory that frees: T may live in the singleton arena rather than on the heap.
+				pool p;
+				if (instance != nullptr && (p.operator->() == nullptr || !p->push(instance)))
 				{
-					s_instance = new T();
-					thread_local_singleton_cleanup_root()->push(
-						[]() -> void
-						{
-							delete s_instance;
-							s_instance = nullptr;
-						});
-					return true;
-				}();
+					factory::destroy(instance);
+				}
 			}
 
-			static inline thread_local T* s_instance;
+			static inline auto dependencies() noexcept -> std::span<singleton_node* const>
+			{
+				return singleton_dependencies<T_DEPS...>::nodes();
+			}
 		};
 	} // namespace details
 
-	template<typename T, typename... T_DEPENDENCIES>
-	using thread_local_singleton = details::thread_local_singleton_base<T, details::singleton_factory<T, T_DEPENDENCIES...>>;
-
-	template<typename T, typename... T_DEPENDENCIES>
-	using thread_local_virtual_singleton = details::thread_local_singleton_base<T, details::virtual_singleton_factory<T>>;
+	template<typename T, size_t T_POOL_CAPACITY = 16, typename... T_DEPENDENCIES>
+	using recycled_thread_local_singleton = details::thread_local_singleton_base<T, details::recycling_singleton_factory<T, T_POOL_CAPACITY, T_DEPENDENCIES...>>;
 
 	template<typename T_SINGLETON>
 	class exported_thread_local_singleton
@@ -601,45 +1514,57 @@ namespace mu
 
 		auto operator->() noexcept -> type*
 		{
-			return s_instance;
+			return m_instance;
 		}
 
 		auto operator->() const noexcept -> const type*
 		{
-			return s_instance;
+			return m_instance;
 		}
 
 		auto operator*() noexcept -> type&
 		{
-			return *s_instance;
+			return *m_instance;
 		}
 
 		auto operator*() const noexcept -> const type&
 		{
-			return *s_instance;
+			return *m_instance;
 		}
 
 		auto get() noexcept -> type*
 		{
-			return s_instance;
+			return m_instance;
 		}
 
 		auto get() const noexcept -> const type*
 		{
-			return s_instance;
+			return m_instance;
 		}
 
 		exported_thread_local_singleton() noexcept
+			: m_instance(s_instance)
+		{
+			if (m_instance == nullptr) [[unlikely]]
+			{
+				m_instance = initialize();
+			}
+		}
+
+	private:
+		MU_NOINLINE static auto initialize() noexcept -> type*
 		{
-			static thread_local bool static_init = []() -> bool
+			[[maybe_unused]] static thread_local bool static_init = []() -> bool
 			{
 				s_instance = get_instance();
 				return true;
 			}();
+			return s_instance;
 		}
 
-	private:
-		static inline thread_local type* s_instance;
+		type* m_instance;
+
+		static inline thread_local type* s_instance = nullptr;
 		static type*					 get_instance() noexcept;
 	};
 
@@ -656,15 +1581,201 @@ namespace mu
 {
 	namespace time
 	{
+		// Where get_now() reads its ticks from. os_monotonic is always available; tsc is only accepted
+		// when the CPU reports an invariant TSC, and is calibrated against the OS clock when selected.
+		enum class tick_source : int
+		{
+			os_monotonic = 0,
+			tsc
+		};
+
+		// What calibrate() measured and chose. Skew and drift are only measured for the TSC; the drift monitor
+		// refreshes tsc_frequency and drift_ppb while the TSC is in use; tsc_skew_ns is measured once, by calibrate().
+		struct calibration_info
+		{
+			tick_source source		  = tick_source::os_monotonic;
+			int64_t		frequency	  = 0; // Ticks per second currently in use
+			int64_t		tsc_frequency = 0; // Last measured TSC rate, 0 if never measured
+			bool		invariant_tsc = false;
+			int64_t		tsc_skew_ns	  = 0; // Spread between the earliest and latest core, -1 if it couldn't be measured
+			int64_t		drift_ppb	  = 0; // Error of the frequency in use against the last measurement
+			int64_t		drift_checks  = 0;
+		};
+
 		auto performance_frequency() noexcept -> int64_t;
 		auto get_now() noexcept -> int64_t;
 		void sleep(const int64_t milliseconds) noexcept;
 		void micro_sleep(const int64_t tx) noexcept;
+		void micro_sleep_until(const int64_t deadline) noexcept; // Absolute, in get_now() ticks
 		void init() noexcept;
+
+		// Measures the TSC against the OS clock and selects the cheapest trustworthy tick_source: the TSC if it is
+		// invariant, stable across two windows and synchronized across cores, otherwise the OS clock. When the TSC
+		// wins, a background thread keeps re-checking it for drift. Like set_tick_source(), call it at startup.
+		// On Windows and macOS the OS clock is already the calibrated TSC, so it only refreshes the frequency.
 		void calibrate() noexcept;
+		auto get_calibration_info() noexcept -> calibration_info;
 		void set_high_resolution_timer() noexcept;
 		auto release_high_resolution_timer() noexcept -> leaf::result<void>;
 
+		// How close micro_sleep() woke to its deadlines since the last reset. micro_sleep() blocks in the kernel for all
+		// but a final slice, then spins; the slice is learned from how late the kernel's wakeups have been. Except on
+		// Windows, whose Sleep() rounds up to the timer period, it is never more than a quarter of the interval.
+		struct micro_sleep_stats
+		{
+			static constexpr size_t bucket_count = 24;
+
+			std::array<int64_t, bucket_count> late_histogram{}; // [0] under 1us late, [i] between 2^(i-1) and 2^i us late
+			int64_t							  sleeps		  = 0;
+			int64_t							  blocked		  = 0; // Sleeps that blocked in the kernel before spinning
+			int64_t							  max_late_ns	  = 0;
+			int64_t							  spin_slice_ns	  = 0; // Current learned spin slice
+			int64_t							  wake_latency_ns = 0; // Smoothed lateness of kernel wakeups
+		};
+
+		auto get_micro_sleep_stats() noexcept -> micro_sleep_stats;
+		void reset_micro_sleep_stats() noexcept;
+
+		// Switching sources changes the tick unit, so do it before taking any moments you intend to keep.
+		auto get_tick_source() noexcept -> tick_source;
+		auto set_tick_source(tick_source source) noexcept -> bool;
+
+		namespace details
+		{
+			struct uint128
+			{
+				uint64_t hi;
+				uint64_t lo;
+			};
+
+			inline auto operator<(const uint128& lhs, const uint128& rhs) noexcept -> bool
+			{
+				return (lhs.hi < rhs.hi) || (lhs.hi == rhs.hi && lhs.lo < rhs.lo);
+			}
+
+			inline auto mul_64x64(const uint64_t a, const uint64_t b) noexcept -> uint128
+			{
+#if defined(__SIZEOF_INT128__)
+				const unsigned __int128 p = static_cast<unsigned __int128>(a) * static_cast<unsigned __int128>(b);
+				return {static_cast<uint64_t>(p >> 64), static_cast<uint64_t>(p)};
+#elif defined(_MSC_VER) && defined(_M_X64)
+				uint128 r;
+				r.lo = _umul128(a, b, &r.hi);
+				return r;
+#else
+				const uint64_t a_lo = a & 0xffffffffull, a_hi = a >> 32;
+				const uint64_t b_lo = b & 0xffffffffull, b_hi = b >> 32;
+				const uint64_t p0 = a_lo * b_lo, p1 = a_lo * b_hi, p2 = a_hi * b_lo, p3 = a_hi * b_hi;
+				const uint64_t mid = (p0 >> 32) + (p1 & 0xffffffffull) + (p2 & 0xffffffffull);
+				return {p3 + (p1 >> 32) + (p2 >> 32) + (mid >> 32), (mid << 32) | (p0 & 0xffffffffull)};
+#endif
+			}
+
+			// floor((remainder << 64) / divisor) for remainder < divisor, by shift-subtract. Only used when building tables.
+			constexpr auto div_fraction(uint64_t remainder, const uint64_t divisor) noexcept -> uint64_t
+			{
+				uint64_t quotient = 0;
+				for (int i = 0; i < 64; ++i)
+				{
+					const bool carry = (remainder >> 63) != 0;
+					remainder <<= 1;
+					quotient <<= 1;
+					if (carry || remainder >= divisor)
+					{
+						remainder -= divisor;
+						quotient |= 1;
+					}
+				}
+				return quotient;
+			}
+
+			// Scales by numerator / denominator using a 64.64 fixed-point factor. The fixed-point estimate is never high
+			// and at most one short, so a single check against the exact 128-bit products makes the integer result
+			// exactly floor(v * numerator / denominator) for every v.
+			struct tick_conversion
+			{
+				uint64_t numerator	 = 1;
+				uint64_t denominator = 1;
+				uint64_t whole		 = 1;
+				uint64_t fraction	 = 0;
+				double	 factor		 = 1.0;
+
+				constexpr tick_conversion() noexcept = default;
+
+				constexpr tick_conversion(const uint64_t n, const uint64_t d) noexcept
+					: numerator(n)
+					, denominator(d)
+					, whole(n / d)
+					, fraction(div_fraction(n % d, d))
+					, factor(static_cast<double>(n) / static_cast<double>(d))
+				{
+				}
+
+				inline auto apply(const uint64_t v) const noexcept -> uint64_t
+				{
+					uint64_t q = v * whole + mul_64x64(v, fraction).hi;
+					if (!(mul_64x64(v, numerator) < mul_64x64(q + 1, denominator)))
+					{
+						++q;
+					}
+					return q;
+				}
+
+				// Integers truncate toward zero (as the old long double casts did, minus their rounding error);
+				// floating point results take a single double multiply.
+				template<typename T_OUT, typename T_IN>
+				inline auto convert(const T_IN& v) const noexcept -> T_OUT
+				{
+					if constexpr (std::is_floating_point_v<T_IN> || std::is_floating_point_v<T_OUT>)
+					{
+						return static_cast<T_OUT>(static_cast<double>(v) * factor);
+					}
+					else
+					{
+						const int64_t  s		= static_cast<int64_t>(v);
+						const uint64_t magnitude = s < 0 ? 0ull - static_cast<uint64_t>(s) : static_cast<uint64_t>(s);
+						const uint64_t scaled	 = apply(magnitude);
+						return static_cast<T_OUT>(s < 0 ? 0ll - static_cast<int64_t>(scaled) : static_cast<int64_t>(scaled));
+					}
+				}
+			};
+
+			struct tick_conversions
+			{
+				tick_conversion to_seconds;
+				tick_conversion to_milliseconds;
+				tick_conversion to_microseconds;
+				tick_conversion to_nanoseconds;
+				tick_conversion from_seconds;
+				tick_conversion from_milliseconds;
+				tick_conversion from_microseconds;
+				tick_conversion from_nanoseconds;
+
+				constexpr tick_conversions() noexcept = default;
+
+				constexpr tick_conversions(const int64_t frequency) noexcept
+					: to_seconds(1ull, frequency)
+					, to_milliseconds(1000ull, frequency)
+					, to_microseconds(1000000ull, frequency)
+					, to_nanoseconds(1000000000ull, frequency)
+					, from_seconds(frequency, 1ull)
+					, from_milliseconds(frequency, 1000ull)
+					, from_microseconds(frequency, 1000000ull)
+					, from_nanoseconds(frequency, 1000000000ull)
+				{
+				}
+			};
+
+			// Republished by init(), tick source changes and the calibration drift monitor. Every publish is a new table
+			// that is never modified or freed, so a republish never tears a conversion that is in flight.
+			extern std::atomic<const tick_conversions*> s_tick_conversions;
+
+			inline auto conversions() noexcept -> const tick_conversions&
+			{
+				return *s_tick_conversions.load(std::memory_order_acquire);
+			}
+		} // namespace details
+
 		class moment
 		{
 			friend class run_time;
@@ -751,26 +1862,25 @@ namespace mu
 			template<typename T>
 			inline auto as_seconds() const noexcept -> T
 			{
-				return static_cast<T>(static_cast<long double>(value) / static_cast<long double>(performance_frequency()));
+				return details::conversions().to_seconds.convert<T>(value);
 			}
 
 			template<typename T>
 			inline auto as_milliseconds() const noexcept -> T
 			{
-				return static_cast<T>(static_cast<long double>(value) / ((static_cast<long double>(performance_frequency()) / static_cast<long double>(1000ull))));
+				return details::conversions().to_milliseconds.convert<T>(value);
 			}
 
 			template<typename T>
 			inline auto as_microseconds() const noexcept -> T
 			{
-				return static_cast<T>(static_cast<long double>(value) / ((static_cast<long double>(performance_frequency()) / static_cast<long double>(1000ull * 1000ull))));
+				return details::conversions().to_microseconds.convert<T>(value);
 			}
 
 			template<typename T>
 			inline auto as_nanoseconds() const noexcept -> T
 			{
-				return static_cast<T>(
-					static_cast<long double>(value) / ((static_cast<long double>(performance_frequency()) / static_cast<long double>(1000ull * 1000ull * 1000ull))));
+				return details::conversions().to_nanoseconds.convert<T>(value);
 			}
 
 			template<typename T>
@@ -782,29 +1892,28 @@ namespace mu
 			template<typename T>
 			inline auto set_seconds(const T& seconds) noexcept -> moment&
 			{
-				value = static_cast<int64_t>((static_cast<long double>(performance_frequency())) * static_cast<long double>(seconds));
+				value = details::conversions().from_seconds.convert<int64_t>(seconds);
 				return *this;
 			}
 
 			template<typename T>
 			inline auto set_milliseconds(const T& seconds) noexcept -> moment&
 			{
-				value = static_cast<int64_t>((static_cast<long double>(performance_frequency()) / static_cast<long double>(1000ull)) * static_cast<long double>(seconds));
+				value = details::conversions().from_milliseconds.convert<int64_t>(seconds);
 				return *this;
 			}
 
 			template<typename T>
 			inline auto set_microseconds(const T& seconds) noexcept -> moment&
 			{
-				value = static_cast<int64_t>((static_cast<long double>(performance_frequency()) / static_cast<long double>(1000ull * 1000ull)) * static_cast<long double>(seconds));
+				value = details::conversions().from_microseconds.convert<int64_t>(seconds);
 				return *this;
 			}
 
 			template<typename T>
 			inline auto set_nanoseconds(const T& seconds) noexcept -> moment&
 			{
-				value = static_cast<int64_t>(
-					(static_cast<long double>(performance_frequency()) / static_cast<long double>(1000ull * 1000ull * 1000ull)) * static_cast<long double>(seconds));
+				value = details::conversions().from_nanoseconds.convert<int64_t>(seconds);
 				return *this;
 			}
 
@@ -822,35 +1931,6 @@ namespace mu
 			}
 		};
 
-		class long_clock
-		{
-			uint64_t value;
-			moment	 last_moment;
-
-		public:
-			long_clock() noexcept : value(0) { }
-
-			template<typename T>
-			inline auto as_seconds() const noexcept -> T
-			{
-				return static_cast<T>(static_cast<long double>(value) / static_cast<long double>(1000ull));
-			}
-
-			template<typename T>
-			inline auto as_milliseconds() const noexcept -> T
-			{
-				return static_cast<T>(static_cast<long double>(value));
-			}
-
-			template<typename T>
-			inline auto as_microseconds() const noexcept -> T
-			{
-				return static_cast<T>(static_cast<long double>(value) * static_cast<long double>(1000ull));
-			}
-
-			void update() noexcept;
-		};
-
 		inline auto operator<(const moment& lhs, const moment& rhs) noexcept -> bool
 		{
 			return lhs.as_ticks<int64_t>() < rhs.as_ticks<int64_t>();
@@ -939,23 +2019,51 @@ namespace mu
 			return t.set_ticks(val);
 		}
 
+		namespace details
+		{
+			// Alone on its cache line so publishing it only ever invalidates readers of the coarse clock.
+			struct alignas(64) coarse_clock
+			{
+				std::atomic<int64_t> ticks{0};
+			};
+
+			extern coarse_clock s_coarse_clock;
+		} // namespace details
+
+		// The moment last published by update_coarse_now() or the coarse clock thread; zero until the first publish.
+		// Costs a single relaxed load, for timestamps (log stamps, TTL checks) that only need the publish period's
+		// precision.
+		inline auto coarse_now() noexcept -> moment
+		{
+			return ticks(details::s_coarse_clock.ticks.load(std::memory_order_relaxed));
+		}
+
+		// Publishes now() to coarse_now(), e.g. once per iteration of a main loop.
+		inline void update_coarse_now() noexcept
+		{
+			details::s_coarse_clock.ticks.store(get_now(), std::memory_order_relaxed);
+		}
+
+		// Runs a background thread that calls update_coarse_now() every period until stop_coarse_clock().
+		void start_coarse_clock(const moment& period) noexcept;
+		void stop_coarse_clock() noexcept;
+
 		template<typename T>
 		inline void micro_sleep_seconds(const T& seconds) noexcept
 		{
-			micro_sleep(static_cast<int64_t>((static_cast<long double>(performance_frequency())) * static_cast<long double>(seconds)));
+			micro_sleep(details::conversions().from_seconds.convert<int64_t>(seconds));
 		}
 
 		template<typename T>
 		inline void micro_sleep_milliseconds(const T& seconds) noexcept
 		{
-			micro_sleep(static_cast<int64_t>((static_cast<long double>(performance_frequency()) / static_cast<long double>(1000ull)) * static_cast<long double>(seconds)));
+			micro_sleep(details::conversions().from_milliseconds.convert<int64_t>(seconds));
 		}
 
 		template<typename T>
 		inline void micro_sleep_microseconds(const T& seconds) noexcept
 		{
-			micro_sleep(
-				static_cast<int64_t>((static_cast<long double>(performance_frequency()) / static_cast<long double>(1000ull * 1000ull)) * static_cast<long double>(seconds)));
+			micro_sleep(details::conversions().from_microseconds.convert<int64_t>(seconds));
 		}
 
 		template<typename T>
@@ -969,6 +2077,11 @@ namespace mu
 			micro_sleep(t.as_ticks<int64_t>());
 		}
 
+		inline void micro_sleep_until(const moment& deadline) noexcept
+		{
+			micro_sleep_until(deadline.as_ticks<int64_t>());
+		}
+
 		template<typename T>
 		inline void sleepseconds(const T& seconds) noexcept
 		{
@@ -998,12 +2111,98 @@ namespace mu
 			sleep(t.template as_milliseconds<int64_t>());
 		}
 
+		// Accumulated time, advanced by one owner thread calling update() and readable from any thread. It sums exact
+		// tick deltas (conversions go through the 128-bit tick_conversion path), so nothing is lost however often it
+		// is updated. Readers go through a seqlock: they never block the owner and never see a half-published update.
+		class long_clock
+		{
+		public:
+			long_clock() noexcept = default;
+
+			long_clock(const long_clock&)					 = delete;
+			auto operator=(const long_clock&) -> long_clock& = delete;
+
+			// Owner thread only.
+			void update() noexcept;
+
+			// Total accumulated as of the last update().
+			inline auto elapsed() const noexcept -> moment
+			{
+				return ticks(read().value);
+			}
+
+			// Total accumulated plus the time since the last update(), for readers that can't wait for the owner's
+			// next tick.
+			inline auto elapsed_now() const noexcept -> moment
+			{
+				const state s = read();
+				return ticks(s.value + static_cast<uint64_t>(std::max<int64_t>(0, get_now() - s.last)));
+			}
+
+			template<typename T>
+			inline auto as_seconds() const noexcept -> T
+			{
+				return details::conversions().to_seconds.convert<T>(static_cast<int64_t>(read().value));
+			}
+
+			template<typename T>
+			inline auto as_milliseconds() const noexcept -> T
+			{
+				return details::conversions().to_milliseconds.convert<T>(static_cast<int64_t>(read().value));
+			}
+
+			template<typename T>
+			inline auto as_microseconds() const noexcept -> T
+			{
+				return details::conversions().to_microseconds.convert<T>(static_cast<int64_t>(read().value));
+			}
+
+			template<typename T>
+			inline auto as_nanoseconds() const noexcept -> T
+			{
+				return details::conversions().to_nanoseconds.convert<T>(static_cast<int64_t>(read().value));
+			}
+
+		private:
+			struct state
+			{
+				uint64_t value;
+				int64_t	 last;
+			};
+
+			inline auto read() const noexcept -> state
+			{
+				for (;;)
+				{
+					const uint32_t before = m_sequence.load(std::memory_order_acquire);
+					if ((before & 1) == 0)
+					{
+						const state s{m_value.load(std::memory_order_relaxed), m_last.load(std::memory_order_relaxed)};
+						std::atomic_thread_fence(std::memory_order_acquire);
+						if (m_sequence.load(std::memory_order_relaxed) == before)
+						{
+							return s;
+						}
+					}
+				}
+			}
+
+			std::atomic<uint32_t> m_sequence{0};
+			std::atomic<uint64_t> m_value{0};
+			std::atomic<int64_t>  m_last{0};
+		};
+
 		inline void long_clock::update() noexcept
 		{
-			const moment n = now();
-			const moment d = n - last_moment;
-			last_moment	   = n;
-			value += d.template as_milliseconds<int64_t>();
+			const int64_t  n		= get_now();
+			const int64_t  last		= m_last.load(std::memory_order_relaxed);
+			const uint32_t sequence = m_sequence.load(std::memory_order_relaxed);
+
+			m_sequence.store(sequence + 1, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_release);
+			m_value.store(m_value.load(std::memory_order_relaxed) + static_cast<uint64_t>(std::max<int64_t>(0, n - last)), std::memory_order_relaxed);
+			m_last.store(n, std::memory_order_relaxed);
+			m_sequence.store(sequence + 2, std::memory_order_release);
 		}
 	} // namespace time
 } // namespace mu
@@ -1129,6 +2328,32 @@ namespace backward
 
 namespace mu
 {
+	namespace singletons
+	{
+		// Builds every registered singleton now (in dependency order) instead of on first use, or only those whose
+		// type declares a matching
+		//     static constexpr std::string_view singleton_group = "...";
+		// along with whatever they depend on.
+		void prewarm() noexcept;
+		void prewarm(std::span<const std::string_view> groups) noexcept;
+
+		struct report_entry
+		{
+			std::string_view			  name;
+			std::string_view			  group;
+			bool						  constructed = false;
+			time::moment				  cost;		  // Its own construction
+			time::moment				  chain_cost; // Its own plus its costliest chain of dependencies
+			std::vector<std::string_view> dependencies;
+			std::vector<std::string_view> critical_chain; // That costliest chain, starting with this singleton
+		};
+
+		// Every registered singleton and its dependencies, costliest chain first. Covers singletons built lazily
+		// or by mu::taskflow::initialize_singletons as well as by prewarm.
+		auto report() noexcept -> std::vector<report_entry>;
+		void log_report(spdlog::logger& l, spdlog::level::level_enum lvl) noexcept;
+	} // namespace singletons
+
 	namespace debug
 	{
 		namespace details
@@ -1140,28 +2365,223 @@ namespace mu
 
 				virtual auto stdout_logger() noexcept -> std::shared_ptr<spdlog::logger> = 0;
 				virtual auto stderr_logger() noexcept -> std::shared_ptr<spdlog::logger> = 0;
+
+				// Messages lost to a full async queue, across both loggers.
+				virtual auto dropped_messages() noexcept -> uint64_t
+				{
+					return 0;
+				}
 			};
 		} // namespace details
 
 		using logger = mu::exported_singleton<mu::virtual_singleton<details::logger_interface>>;
 
+		enum class log_overflow_policy
+		{
+			block = 0,	 // Wait for the writer to make room
+			drop_newest, // Discard the message being logged
+			drop_oldest	 // Discard the oldest queued message to make room
+		};
+
+		struct logger_options
+		{
+			// Log calls only format and enqueue; a background thread per logger does the writing. Flushing the
+			// logger (as the terminate handler does) drains its queue on the calling thread.
+			bool				async		   = false;
+			log_overflow_policy overflow	   = log_overflow_policy::block;
+			uint32_t			queue_capacity = 8192; // Messages, rounded up to a power of two
+
+			// Also run a writer for MU_BINLOG records (mu_stdlib_binlog.h): it formats them to the stdout logger,
+			// or with binary_path set, copies them unformatted to that file for mu_binlog_decode.
+			bool		binary = false;
+			std::string binary_path;
+
+			// How often the stderr logger reports what log_limiter suppressed; zero leaves it to
+			// report_suppressed_logs().
+			time::moment suppressed_report_period = time::seconds(10);
+		};
+
+		// Takes effect when the logger is built, so call it before anything logs; returns false once it has been.
+		// With binary set, it builds the logger straight away.
+		auto configure_logger(const logger_options& options) noexcept -> bool;
+
+		// Limits one log site (the MU_LOG_* macros keep one as a static at each): a token bucket of burst messages
+		// refilled at per_second, behind a 1-in-sample_every sampler; a zero per_second leaves only the sampling.
+		// Lock-free, and constant-initialized for constant arguments. What it suppresses is counted and reported by
+		// report_suppressed_logs(), which keeps hold of it from then on: a limiter has to be static.
+		class log_limiter
+		{
+		public:
+			static constexpr uint32_t default_per_second = 10;
+			static constexpr uint32_t default_burst		 = 20;
+
+			constexpr log_limiter(const char* file, const uint32_t line, const uint32_t per_second = default_per_second, const uint32_t burst = default_burst,
+								  const uint32_t sample_every = 1) noexcept
+				: m_file(file)
+				, m_line(line)
+				, m_per_second(per_second)
+				, m_burst(burst > 0 ? burst : 1)
+				, m_sample_every(sample_every > 0 ? sample_every : 1)
+			{
+			}
+
+			log_limiter(const log_limiter&)					   = delete;
+			auto operator=(const log_limiter&) -> log_limiter& = delete;
+
+			// Whether to log this message; if not, it's counted as suppressed.
+			auto allow() noexcept -> bool
+			{
+				if (m_sample_every > 1 && m_seen.fetch_add(1, std::memory_order_relaxed) % m_sample_every != 0)
+				{
+					suppress();
+					return false;
+				}
+				if (m_per_second == 0)
+				{
+					return true;
+				}
+
+				// GCRA, as time::rate_limiter, with the interval worked out per call since the tick frequency isn't
+				// known at constant initialization.
+				const int64_t t		   = time::get_now();
+				const int64_t interval = std::max<int64_t>(1, time::performance_frequency() / m_per_second);
+				const int64_t capacity = interval * m_burst;
+
+				int64_t tat = m_tat.load(std::memory_order_relaxed);
+				for (;;)
+				{
+					const int64_t next = std::max(tat, t) + interval;
+					if (next - t > capacity)
+					{
+						suppress();
+						return false;
+					}
+					if (m_tat.compare_exchange_weak(tat, next, std::memory_order_relaxed))
+					{
+						return true;
+					}
+				}
+			}
+
+			// Messages suppressed since the last call.
+			auto take_suppressed() noexcept -> uint64_t
+			{
+				return m_suppressed.exchange(0, std::memory_order_relaxed);
+			}
+
+			auto file() const noexcept -> const char*
+			{
+				return m_file;
+			}
+
+			auto line() const noexcept -> uint32_t
+			{
+				return m_line;
+			}
+
+		private:
+			friend void report_suppressed_logs(spdlog::logger& l) noexcept;
+
+			void suppress() noexcept
+			{
+				m_suppressed.fetch_add(1, std::memory_order_relaxed);
+				if (!m_registered.load(std::memory_order_relaxed) && !m_registered.exchange(true, std::memory_order_relaxed))
+				{
+					enlist(this);
+				}
+			}
+
+			// Adds a limiter to the list report_suppressed_logs() walks, on its first suppression; never removed.
+			static void enlist(log_limiter* limiter) noexcept;
+
+			const char* const	  m_file;
+			const uint32_t		  m_line;
+			const uint32_t		  m_per_second;
+			const uint32_t		  m_burst;
+			const uint32_t		  m_sample_every;
+			std::atomic<int64_t>  m_tat{0};
+			std::atomic<uint64_t> m_seen{0};
+			std::atomic<uint64_t> m_suppressed{0};
+			std::atomic<bool>	  m_registered{false};
+			log_limiter*		  m_next = nullptr;
+		};
+
+		// Logs, at warn, how many messages each limited site has suppressed since the last report; sites with none
+		// are skipped. The logger does this on its own every logger_options::suppressed_report_period.
+		void report_suppressed_logs(spdlog::logger& l) noexcept;
+
+		// The limiter for errors raised at file:line, for code that logs them away from where they were raised (as
+		// error_handlers does), so that one failing site can't use up every other site's budget. Sites past the
+		// table's capacity share one limiter.
+		auto error_site_limiter(const char* file, uint32_t line) noexcept -> log_limiter&;
+
+		// A stack as raw return addresses, captured without allocating or looking up symbols. Cheap enough to take on
+		// warning paths; resolution waits until (and unless) it is logged.
+		struct stack_capture
+		{
+			static constexpr uint32_t max_frames = 64;
+
+			std::array<void*, max_frames> frames;
+			uint32_t					  size = 0;
+		};
+
+		auto capture_stack_trace(unsigned int level_skip = 0) noexcept -> stack_capture;
+
+		// Both resolve through a process-wide address -> symbol cache, so a trace through code that has been
+		// logged before costs lookups rather than a debug-info search.
+		void log_stack_trace(spdlog::logger& l, spdlog::level::level_enum lvl, const stack_capture& trace) noexcept;
 		void log_stack_trace(spdlog::logger& l, spdlog::level::level_enum lvl, unsigned int level_skip) noexcept;
 
+		struct symbol_cache_stats
+		{
+			uint64_t hits	 = 0; // Frames found already resolved
+			uint64_t misses	 = 0; // Frames resolved from debug info
+			size_t	 entries = 0;
+		};
+
+		auto get_symbol_cache_stats() noexcept -> symbol_cache_stats;
+
+		// Starts loading debug info for symbolization on a background thread; the logger does this when it's built,
+		// and later calls return the same future (false if no thread could be started, in which case the first trace
+		// logged loads it). Stack traces logged before it's ready show raw addresses rather than wait.
+		auto load_symbols() noexcept -> std::shared_future<bool>;
+
 	} // namespace debug
 
-	static inline auto error_handlers = std::make_tuple(
-		[](runtime_error::not_specified x, leaf::e_source_location sl)
-		{
-			debug::logger()->stderr_logger()->log(spdlog::level::err, "{0} :: {1} -> {2} : runtime_error :: not_specified", sl.line, sl.file, sl.function);
-		},
-		[](common_error x, leaf::e_source_location sl)
+	namespace details
+	{
+		// Limited per raising site, except in the terminate handler: the fatal error's line is never the one dropped.
+		inline void log_error(const bool limited, const leaf::e_source_location& sl, const char* what) noexcept
 		{
-			debug::logger()->stderr_logger()->log(spdlog::level::err, "{0} :: {1} -> {2} : common_error", sl.line, sl.file, sl.function);
-		},
-		[]
+			if (!limited || debug::error_site_limiter(sl.file, static_cast<uint32_t>(sl.line)).allow())
+			{
+				debug::logger()->stderr_logger()->log(spdlog::level::err, "{0} :: {1} -> {2} : {3}", sl.line, sl.file, sl.function, what);
+			}
+		}
+
+		inline auto make_error_handlers(const bool limited)
 		{
-			debug::logger()->stderr_logger()->log(spdlog::level::err, "???");
-		});
+			return std::make_tuple(
+				[limited]([[maybe_unused]] runtime_error::not_specified x, leaf::e_source_location sl)
+				{
+					log_error(limited, sl, "runtime_error :: not_specified");
+				},
+				[limited]([[maybe_unused]] common_error x, leaf::e_source_location sl)
+				{
+					log_error(limited, sl, "common_error");
+				},
+				[limited]
+				{
+					static ::mu::debug::log_limiter unknown_errors(__FILE__, __LINE__);
+					if (!limited || unknown_errors.allow())
+					{
+						debug::logger()->stderr_logger()->log(spdlog::level::err, "???");
+					}
+				});
+		}
+	} // namespace details
+
+	static inline auto error_handlers = details::make_error_handlers(true);
 
 	template<class TryBlock>
 	constexpr inline auto try_handle(TryBlock&& try_block) -> typename std::decay<decltype(std::declval<TryBlock>()().value())>::type
@@ -0,0 +1,284 @@
+#pragma once
+
+#include <mu_stdlib.h>
+
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+
+// Deferred-format logging. A call site records only its site id, a timestamp and the raw bytes of its arguments into
+// the calling thread's ring; the formatting happens later, on the binary logger's writer thread, or offline when
+// the records go to a capture file instead (see tools/mu_binlog_decode.cpp).
+//
+//     mu::debug::logger_options options;
+//     options.binary      = true;
+//     options.binary_path = "run.mubin"; // Leave empty to have the writer format to the stdout logger
+//     mu::debug::configure_logger(options);
+//
+//     MU_BINLOG(info, "frame {0} took {1:.3f} ms", frame, ms);
+//
+// Format strings must be literals: only the site is recorded. Arguments are limited to arithmetic types, enums,
+// pointers and strings, which are copied. Until a binary logger exists, MU_BINLOG records nothing.
+
+#define MU_BINLOG(lvl, format, ...)                                                                                                                                                \
+	do                                                                                                                                                                             \
+	{                                                                                                                                                                              \
+		static constexpr ::mu::binlog::source mu_binlog_source{::spdlog::level::lvl, format, __FILE__, __LINE__};                                                                  \
+		static std::atomic<uint32_t>		  mu_binlog_site{0};                                                                                                                   \
+		::mu::binlog::details::log(mu_binlog_source, mu_binlog_site __VA_OPT__(, ) __VA_ARGS__);                                                                                   \
+	}                                                                                                                                                                              \
+	while (0)
+
+namespace mu
+{
+	namespace binlog
+	{
+		struct source
+		{
+			spdlog::level::level_enum level;
+			const char*				  format;
+			const char*				  file;
+			uint32_t				  line;
+		};
+
+		namespace details
+		{
+			// Every record starts with this, and is padded to a multiple of 8 bytes. A site of 0 marks the padding
+			// that fills the end of a ring when the next record wouldn't fit; only its first 8 bytes are written.
+			struct record_header
+			{
+				uint32_t site;
+				uint32_t size; // Including this header
+				int64_t	 timestamp;
+			};
+
+			// One code per argument, kept with the site so the decoder knows how to read the bytes back:
+			//     b bool, c char (1 byte); i signed, u unsigned, d floating, p pointer (8 bytes);
+			//     s string (uint32_t length, then the bytes).
+			template<typename T>
+			constexpr auto type_code() noexcept -> char
+			{
+				using U = std::remove_cvref_t<T>;
+				if constexpr (std::is_same_v<U, bool>)
+				{
+					return 'b';
+				}
+				else if constexpr (std::is_same_v<U, char>)
+				{
+					return 'c';
+				}
+				else if constexpr (std::is_enum_v<U>)
+				{
+					return type_code<std::underlying_type_t<U>>();
+				}
+				else if constexpr (std::is_integral_v<U>)
+				{
+					return std::is_signed_v<U> ? 'i' : 'u';
+				}
+				else if constexpr (std::is_floating_point_v<U>)
+				{
+					return 'd';
+				}
+				else if constexpr (std::is_convertible_v<const U&, std::string_view>)
+				{
+					return 's';
+				}
+				else
+				{
+					static_assert(std::is_pointer_v<U>, "MU_BINLOG arguments must be arithmetic, enums, pointers or strings");
+					return 'p';
+				}
+			}
+
+			template<typename... T>
+			struct signature
+			{
+				static constexpr char value[] = {type_code<T>()..., '\0'};
+			};
+
+			template<typename T>
+			inline auto encoded_size(const T& arg) noexcept -> uint32_t
+			{
+				if constexpr (type_code<T>() == 'b' || type_code<T>() == 'c')
+				{
+					return 1;
+				}
+				else if constexpr (type_code<T>() == 's')
+				{
+					return static_cast<uint32_t>(sizeof(uint32_t) + std::string_view(arg).size());
+				}
+				else
+				{
+					return 8;
+				}
+			}
+
+			template<typename T>
+			constexpr auto as_integer(const T v) noexcept
+			{
+				if constexpr (std::is_enum_v<T>)
+				{
+					return static_cast<std::underlying_type_t<T>>(v);
+				}
+				else
+				{
+					return v;
+				}
+			}
+
+			template<typename T>
+			inline auto encode(std::byte* out, const T& arg) noexcept -> std::byte*
+			{
+				constexpr char code = type_code<T>();
+				if constexpr (code == 'b' || code == 'c')
+				{
+					std::memcpy(out, &arg, 1);
+					return out + 1;
+				}
+				else if constexpr (code == 's')
+				{
+					const std::string_view s(arg);
+					const uint32_t		   length = static_cast<uint32_t>(s.size());
+					std::memcpy(out, &length, sizeof(length));
+					std::memcpy(out + sizeof(length), s.data(), length);
+					return out + sizeof(length) + length;
+				}
+				else
+				{
+					if constexpr (code == 'p')
+					{
+						const uint64_t v = reinterpret_cast<uintptr_t>(arg);
+						std::memcpy(out, &v, 8);
+					}
+					else if constexpr (code == 'd')
+					{
+						const double v = static_cast<double>(arg);
+						std::memcpy(out, &v, 8);
+					}
+					else if constexpr (code == 'i')
+					{
+						const int64_t v = static_cast<int64_t>(as_integer(arg));
+						std::memcpy(out, &v, 8);
+					}
+					else
+					{
+						const uint64_t v = static_cast<uint64_t>(as_integer(arg));
+						std::memcpy(out, &v, 8);
+					}
+					return out + 8;
+				}
+			}
+
+			// Single producer (the owning thread), single consumer (the binary logger's writer). When full, new
+			// records are dropped and counted rather than overwriting ones the writer hasn't read.
+			struct alignas(64) thread_ring
+			{
+				static constexpr uint32_t capacity = 1u << 20;
+				static constexpr uint32_t mask	   = capacity - 1;
+
+				alignas(64) std::atomic<uint64_t> head{0};
+				uint64_t cached_tail = 0;
+				alignas(64) std::atomic<uint64_t> tail{0};
+				std::atomic<uint64_t> dropped{0};
+				std::atomic<bool>	  retired{false};
+				uint32_t			  id = 0;
+				alignas(8) std::byte data[capacity];
+
+				// Returns where to write size bytes, or nullptr if they don't fit; at is what to pass to commit().
+				inline auto reserve(const uint32_t size, uint64_t& at) noexcept -> std::byte*
+				{
+					uint64_t	   h		 = head.load(std::memory_order_relaxed);
+					const uint32_t remaining = capacity - static_cast<uint32_t>(h & mask);
+					const uint64_t needed	 = size + (size > remaining ? remaining : 0);
+					if (h + needed - cached_tail > capacity)
+					{
+						cached_tail = tail.load(std::memory_order_acquire);
+						if (h + needed - cached_tail > capacity)
+						{
+							dropped.store(dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+							return nullptr;
+						}
+					}
+					if (size > remaining)
+					{
+						const uint32_t pad[2] = {0, remaining};
+						std::memcpy(data + (h & mask), pad, sizeof(pad));
+						h += remaining;
+					}
+					at = h;
+					return data + (h & mask);
+				}
+
+				inline void commit(const uint64_t at, const uint32_t size) noexcept
+				{
+					head.store(at + size, std::memory_order_release);
+				}
+			};
+
+			inline thread_local thread_ring* t_ring = nullptr;
+
+			// Records below this level are skipped at the call site; off until a binary logger is running.
+			inline std::atomic<int> g_level{spdlog::level::off};
+
+			auto register_thread() noexcept -> thread_ring*;
+			auto register_site(const source& src, const char* signature, std::atomic<uint32_t>& site) noexcept -> uint32_t;
+
+			template<typename... T>
+			inline void log(const source& src, std::atomic<uint32_t>& site, const T&... args) noexcept
+			{
+				if (src.level < g_level.load(std::memory_order_relaxed))
+				{
+					return;
+				}
+
+				uint32_t id = site.load(std::memory_order_relaxed);
+				if (id == 0) [[unlikely]]
+				{
+					id = register_site(src, signature<T...>::value, site);
+					if (id == 0)
+					{
+						return;
+					}
+				}
+
+				thread_ring* ring = t_ring;
+				if (ring == nullptr) [[unlikely]]
+				{
+					ring = register_thread();
+					if (ring == nullptr)
+					{
+						return;
+					}
+				}
+
+				const uint32_t size = (static_cast<uint32_t>(sizeof(record_header)) + (0 + ... + encoded_size(args)) + 7) & ~7u;
+				if (size > thread_ring::capacity / 4)
+				{
+					ring->dropped.store(ring->dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+					return;
+				}
+
+				uint64_t   at;
+				std::byte* out = ring->reserve(size, at);
+				if (out == nullptr)
+				{
+					return;
+				}
+
+				const record_header header{id, size, time::get_now()};
+				std::memcpy(out, &header, sizeof(header));
+				out += sizeof(header);
+				((out = encode(out, args)), ...);
+				ring->commit(at, size);
+			}
+		} // namespace details
+
+		// Records dropped because a ring was full, or a record too large for one.
+		auto dropped() noexcept -> uint64_t;
+
+		// Formats every record in a capture written with logger_options::binary_path to l, at each site's level and
+		// with its original timestamp. The capture must come from a build with the same type encoding (any build of
+		// this version), on a machine of the same endianness.
+		auto decode_file(const char* path, spdlog::logger& l) noexcept -> bool;
+	} // namespace binlog
+} // namespace mu
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <mu_stdlib.h>
+
+#include <vector>
+
+// Crash dumps. Once installed, a crash (SIGSEGV, SIGBUS, SIGILL, SIGFPE, SIGABRT, an unhandled SEH exception on
+// Windows) or std::terminate writes the raw return addresses, the fault address and the table of loaded modules,
+// with their build ids, to one file. Nothing is resolved or formatted in the dying process: the handler only copies
+// preallocated memory and makes async-signal-safe calls. tools/mu_crash_symbolize.cpp turns the file into traces.
+//
+//     mu::crash::install("crash-1234.mudump");
+//     ...
+//     mu::crash::prepare_thread();  // First thing on every other thread
+//     mu::crash::refresh_modules(); // After loading plugins
+//
+// The module table is taken at install() and refresh_modules(), since walking the loader's list at crash time
+// isn't safe. A stack overflow can only be dumped on a thread that has room set aside to run the handler in: the
+// one that called install(), and any that have called prepare_thread(). Other crashes are caught on every thread.
+
+namespace mu
+{
+	namespace crash
+	{
+		enum class dump_kind : uint32_t
+		{
+			terminate = 1, // code is 0
+			signal,		   // code is the signal number
+			exception	   // code is the SEH exception code (Windows)
+		};
+
+		// File layout, native byte order: dump_header, then module_count dump_module.
+		struct dump_header
+		{
+			static constexpr uint32_t max_frames = 64;
+
+			char	  magic[8];
+			dump_kind kind;
+			uint32_t  code;
+			uint32_t  frame_count;
+			uint32_t  module_count;
+			uint64_t  fault_address; // Where a memory fault was, when the platform says
+			int64_t	  time;			 // Seconds since the epoch
+			uint64_t  frames[max_frames];
+		};
+
+		struct dump_module
+		{
+			uint64_t start; // Mapped range
+			uint64_t end;
+			uint64_t bias;			// Subtract from a frame for the address as the module file has it
+			uint32_t build_id_size; // GNU build id, Mach-O LC_UUID, or CodeView GUID and age
+			uint8_t	 build_id[32];
+			char	 path[500];
+		};
+
+		struct dump
+		{
+			dump_header				 header;
+			std::vector<dump_module> modules;
+
+			// The module a frame falls in, or nullptr.
+			auto find_module(uint64_t address) const noexcept -> const dump_module*;
+		};
+
+		// Handles crashes from now on, writing them to path (truncated to 1023 characters). Again replaces the path
+		// and refreshes the module table.
+		auto install(const char* path) noexcept -> bool;
+
+		// Takes a new module table snapshot; call after loading or unloading libraries.
+		void refresh_modules() noexcept;
+
+		// Sets aside the calling thread's stack for the crash handler (an alternate signal stack of 64KB, or a stack
+		// guarantee on Windows), so that overflowing this thread's stack still writes a dump. Released when the
+		// thread exits; calling it again is harmless.
+		auto prepare_thread() noexcept -> bool;
+
+		auto read_dump(const char* path, dump& out) noexcept -> bool;
+
+		namespace details
+		{
+			// Writes a terminate dump if crash handling is installed and nothing has been written yet; true if a dump
+			// is on disk, this one or an earlier crash's. For terminate handlers that replace or follow the one
+			// install() sets.
+			auto on_terminate() noexcept -> bool;
+		} // namespace details
+	} // namespace crash
+} // namespace mu
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <mu_stdlib.h>
+
+// Flight recorder. Every thread writes fixed-size events into a ring that is a memory-mapped file of its own, so
+// what it recorded sits in the page cache, and reaches the disk, even when the process dies by SIGKILL or a crash
+// that runs no handlers at all. Afterwards tools/mu_flight_decode.cpp prints the last seconds of every thread.
+//
+//     mu::flight::start("flight-1234"); // A directory per run; created if need be
+//     mu::flight::set_thread_name("render");
+//
+//     MU_FLIGHT("frame begin", frame);
+//     MU_FLIGHT("upload", buffer_id, bytes);
+//
+// Event names must be literals: only the site is recorded, along with up to two integers. Rings wrap, keeping
+// each thread's most recent events. Until start() succeeds, MU_FLIGHT records nothing.
+//
+// A thread's ring outlives it until another thread registers and takes it over, so the directory holds one
+// thread-N.mufl per thread that was recording at the busiest moment, each 80 bytes plus 32 per event: 2 MB at the
+// default size. Thread churn doesn't grow it, but an exited thread's events only last until its ring is reused.
+
+#define MU_FLIGHT(name, ...)                                                                                                                                                       \
+	do                                                                                                                                                                             \
+	{                                                                                                                                                                              \
+		static constexpr ::mu::flight::source mu_flight_source{name, __FILE__, __LINE__};                                                                                          \
+		static std::atomic<uint32_t>		  mu_flight_site{0};                                                                                                                   \
+		::mu::flight::details::record(mu_flight_source, mu_flight_site __VA_OPT__(, ) __VA_ARGS__);                                                                                \
+	}                                                                                                                                                                              \
+	while (0)
+
+namespace mu
+{
+	namespace flight
+	{
+		struct source
+		{
+			const char* name;
+			const char* file;
+			uint32_t	line;
+		};
+
+		namespace details
+		{
+			struct event
+			{
+				int64_t	 timestamp; // get_now() ticks
+				int64_t	 a;
+				int64_t	 b;
+				uint32_t site;
+			};
+			static_assert(sizeof(event) == 32);
+
+			// Start of every ring file; the events follow it. head only grows, and is stored after the event it
+			// counts, so whatever the process died doing, the events below head are whole. Except the oldest one
+			// once the ring has wrapped: that slot is the one being overwritten, and the decoder skips it.
+			struct ring_header
+			{
+				char	 magic[8];
+				uint32_t capacity; // Events, a power of two
+				uint32_t thread;   // Number of the ring file, from 1; kept when another thread takes the ring over
+				int64_t	 frequency;
+				int64_t	 base_ticks; // get_now() at base_wall_ns
+				int64_t	 base_wall_ns;
+				char	 name[32];
+				uint64_t head; // Stored through std::atomic_ref, so the header stays trivially copyable
+			};
+
+			inline thread_local ring_header* t_ring = nullptr;
+
+			inline std::atomic<bool> g_running{false};
+
+			auto register_thread() noexcept -> ring_header*;
+			auto register_site(const source& src, std::atomic<uint32_t>& site) noexcept -> uint32_t;
+
+			inline void record(const source& src, std::atomic<uint32_t>& site, const int64_t a = 0, const int64_t b = 0) noexcept
+			{
+				if (!g_running.load(std::memory_order_relaxed))
+				{
+					return;
+				}
+
+				uint32_t id = site.load(std::memory_order_relaxed);
+				if (id == 0) [[unlikely]]
+				{
+					id = register_site(src, site);
+					if (id == 0)
+					{
+						return;
+					}
+				}
+
+				ring_header* ring = t_ring;
+				if (ring == nullptr) [[unlikely]]
+				{
+					ring = register_thread();
+					if (ring == nullptr)
+					{
+						return;
+					}
+				}
+
+				const uint64_t h = ring->head;
+				reinterpret_cast<event*>(ring + 1)[h & (ring->capacity - 1)] = {time::get_now(), a, b, id};
+				std::atomic_ref<uint64_t>(ring->head).store(h + 1, std::memory_order_release);
+			}
+		} // namespace details
+
+		// Creates directory if it doesn't exist and starts recording into it, with rings of events_per_thread
+		// events (rounded up to a power of two) of 32 bytes each. Once per process; false if that has already
+		// happened or the directory can't be written.
+		auto start(const char* directory, uint32_t events_per_thread = 1u << 16) noexcept -> bool;
+
+		// Names the calling thread's ring in the decoder's output. Truncated to 31 characters.
+		void set_thread_name(const char* name) noexcept;
+
+		// Logs, oldest first across all threads, every event in directory that was recorded within window of the
+		// newest one. Each message carries its original time and its thread's ring file number as its thread id.
+		auto decode(const char* directory, const time::moment& window, spdlog::logger& l) noexcept -> bool;
+	} // namespace flight
+} // namespace mu
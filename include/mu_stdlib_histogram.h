@@ -0,0 +1,302 @@
+#pragma once
+
+#include <mu_stdlib.h>
+
+#include <algorithm>
+#include <bit>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace mu
+{
+	namespace time
+	{
+		// Log-linear bucketing in the style of HdrHistogram: values below 2^T_PRECISION_BITS get a bucket each, and every
+		// power of two above that is split into 2^T_PRECISION_BITS linear sub-buckets, so any recorded value is known to
+		// within 1 / 2^T_PRECISION_BITS of itself (~3% at the default of 5) across the whole 64-bit tick range.
+		template<uint32_t T_PRECISION_BITS>
+		struct histogram_buckets
+		{
+			static constexpr uint32_t precision_bits = T_PRECISION_BITS;
+			static constexpr uint32_t sub_buckets	 = 1u << precision_bits;
+			static constexpr uint32_t count			 = (65 - precision_bits) * sub_buckets;
+
+			static inline auto index_of(const uint64_t value) noexcept -> uint32_t
+			{
+				if (value < sub_buckets)
+				{
+					return static_cast<uint32_t>(value);
+				}
+				const uint32_t shift = static_cast<uint32_t>(std::bit_width(value)) - 1 - precision_bits;
+				return (shift + 1) * sub_buckets + static_cast<uint32_t>((value >> shift) - sub_buckets);
+			}
+
+			static inline auto lowest_value(const uint32_t index) noexcept -> uint64_t
+			{
+				if (index < sub_buckets)
+				{
+					return index;
+				}
+				const uint32_t shift = index / sub_buckets - 1;
+				return static_cast<uint64_t>(sub_buckets + index % sub_buckets) << shift;
+			}
+
+			static inline auto highest_value(const uint32_t index) noexcept -> uint64_t
+			{
+				return index < sub_buckets ? index : lowest_value(index) + ((1ull << (index / sub_buckets - 1)) - 1);
+			}
+		};
+
+		// A merged, point-in-time copy of a histogram. Values are moment ticks; percentiles report the highest value
+		// that shares the percentile's bucket, so they never understate a latency.
+		template<uint32_t T_PRECISION_BITS = 5>
+		class histogram_snapshot
+		{
+		public:
+			using buckets = histogram_buckets<T_PRECISION_BITS>;
+
+			histogram_snapshot()
+				: m_counts(buckets::count, 0)
+			{
+			}
+
+			auto count() const noexcept -> uint64_t
+			{
+				return m_total;
+			}
+
+			auto min() const noexcept -> moment
+			{
+				for (uint32_t i = 0; i < buckets::count; ++i)
+				{
+					if (m_counts[i] != 0)
+					{
+						return ticks(buckets::lowest_value(i));
+					}
+				}
+				return moment();
+			}
+
+			auto max() const noexcept -> moment
+			{
+				for (uint32_t i = buckets::count; i > 0; --i)
+				{
+					if (m_counts[i - 1] != 0)
+					{
+						return ticks(buckets::highest_value(i - 1));
+					}
+				}
+				return moment();
+			}
+
+			auto mean() const noexcept -> moment
+			{
+				return m_total != 0 ? ticks(m_sum / m_total) : moment();
+			}
+
+			// p in [0, 100], e.g. 50, 99, 99.9.
+			auto percentile(const double p) const noexcept -> moment
+			{
+				if (m_total == 0)
+				{
+					return moment();
+				}
+
+				const uint64_t rank = std::clamp<uint64_t>(static_cast<uint64_t>(static_cast<double>(m_total) * p / 100.0 + 0.5), 1, m_total);
+				uint64_t	   seen = 0;
+				for (uint32_t i = 0; i < buckets::count; ++i)
+				{
+					seen += m_counts[i];
+					if (seen >= rank)
+					{
+						return ticks(buckets::highest_value(i));
+					}
+				}
+				return max();
+			}
+
+			void merge(const histogram_snapshot& other) noexcept
+			{
+				for (uint32_t i = 0; i < buckets::count; ++i)
+				{
+					m_counts[i] += other.m_counts[i];
+				}
+				m_total += other.m_total;
+				m_sum += other.m_sum;
+			}
+
+			void add(const uint32_t index, const uint64_t n) noexcept
+			{
+				m_counts[index] += n;
+				m_total += n;
+			}
+
+			void add_sum(const uint64_t sum) noexcept
+			{
+				m_sum += sum;
+			}
+
+			auto bucket_count(const uint32_t index) const noexcept -> uint64_t
+			{
+				return m_counts[index];
+			}
+
+		private:
+			std::vector<uint64_t> m_counts;
+			uint64_t			  m_total = 0;
+			uint64_t			  m_sum	  = 0;
+		};
+
+		// Records moment deltas without locks or allocation (after a thread's first record). Each thread writes to its
+		// own shard, picked by mu::thread_index(), with plain load/store increments; snapshot() sums the shards. Threads
+		// beyond T_MAX_THREADS share an overflow shard that uses atomic adds.
+		//
+		// snapshot(true) is reset-on-read without touching the writers: the reader keeps a baseline per shard and
+		// reports only what was recorded since the previous resetting snapshot.
+		template<uint32_t T_PRECISION_BITS = 5, uint32_t T_MAX_THREADS = 256>
+		class histogram
+		{
+		public:
+			using buckets		= histogram_buckets<T_PRECISION_BITS>;
+			using snapshot_type = histogram_snapshot<T_PRECISION_BITS>;
+
+			histogram() = default;
+
+			~histogram()
+			{
+				for (auto& s : m_shards)
+				{
+					delete s.load(std::memory_order_acquire);
+				}
+			}
+
+			histogram(const histogram&)					   = delete;
+			auto operator=(const histogram&) -> histogram& = delete;
+
+			inline void record(const moment& delta) noexcept
+			{
+				record_ticks(delta.as_ticks<int64_t>());
+			}
+
+			inline void record_ticks(const int64_t delta) noexcept
+			{
+				const uint64_t value = static_cast<uint64_t>(std::max<int64_t>(0, delta));
+				const uint32_t index = buckets::index_of(value);
+
+				const uint32_t thread = thread_index();
+				if (thread < T_MAX_THREADS)
+				{
+					if (shard* s = local_shard(thread))
+					{
+						s->counts[index].store(s->counts[index].load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+						s->sum.store(s->sum.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+						return;
+					}
+				}
+
+				m_overflow.counts[index].fetch_add(1, std::memory_order_relaxed);
+				m_overflow.sum.fetch_add(value, std::memory_order_relaxed);
+			}
+
+			// Records the time from construction to destruction.
+			class scope
+			{
+			public:
+				scope(histogram& h) noexcept
+					: m_histogram(h)
+					, m_start(get_now())
+				{
+				}
+
+				~scope()
+				{
+					m_histogram.record_ticks(get_now() - m_start);
+				}
+
+			private:
+				histogram& m_histogram;
+				int64_t	   m_start;
+			};
+
+			auto snapshot(const bool reset = false) -> snapshot_type
+			{
+				std::lock_guard<std::mutex> lock(m_snapshot_mutex);
+
+				snapshot_type result;
+				for (uint32_t i = 0; i < T_MAX_THREADS; ++i)
+				{
+					if (const shard* s = m_shards[i].load(std::memory_order_acquire))
+					{
+						collect(*s, m_baselines[i], result, reset);
+					}
+				}
+				collect(m_overflow, m_overflow_baseline, result, reset);
+				return result;
+			}
+
+		private:
+			struct alignas(64) shard
+			{
+				std::atomic<uint64_t> counts[buckets::count] = {};
+				std::atomic<uint64_t> sum{0};
+			};
+
+			struct baseline
+			{
+				std::unique_ptr<uint64_t[]> counts;
+				uint64_t					sum = 0;
+			};
+
+			inline auto local_shard(const uint32_t thread) noexcept -> shard*
+			{
+				shard* s = m_shards[thread].load(std::memory_order_acquire);
+				if (s == nullptr)
+				{
+					// Only this thread writes this slot until it exits, so publishing needs no CAS. A thread that
+					// later inherits the index keeps adding to the same shard.
+					s = new (std::nothrow) shard();
+					m_shards[thread].store(s, std::memory_order_release);
+				}
+				return s;
+			}
+
+			static void collect(const shard& s, baseline& base, snapshot_type& result, const bool reset)
+			{
+				if (reset && !base.counts)
+				{
+					base.counts = std::make_unique<uint64_t[]>(buckets::count);
+				}
+
+				for (uint32_t i = 0; i < buckets::count; ++i)
+				{
+					const uint64_t now	 = s.counts[i].load(std::memory_order_relaxed);
+					const uint64_t since = base.counts ? base.counts[i] : 0;
+					if (now != since)
+					{
+						result.add(i, now - since);
+					}
+					if (reset)
+					{
+						base.counts[i] = now;
+					}
+				}
+
+				const uint64_t sum = s.sum.load(std::memory_order_relaxed);
+				result.add_sum(sum - base.sum);
+				if (reset)
+				{
+					base.sum = sum;
+				}
+			}
+
+			std::atomic<shard*> m_shards[T_MAX_THREADS] = {};
+			shard				m_overflow;
+
+			std::mutex m_snapshot_mutex;
+			baseline   m_baselines[T_MAX_THREADS];
+			baseline   m_overflow_baseline;
+		};
+	} // namespace time
+} // namespace mu
@@ -0,0 +1,217 @@
+#pragma once
+
+#include <mu_stdlib.h>
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace mu
+{
+	namespace time
+	{
+		enum class pacer_policy
+		{
+			catch_up = 0, // After an overrun, report the missed steps (up to a limit) so a simulation can run them
+			skip		  // After an overrun, drop the missed steps and rejoin the schedule at the next deadline
+		};
+
+		struct pacer_stats
+		{
+			int64_t frames		= 0;
+			int64_t overruns	= 0; // wait() called after its deadline had already passed
+			int64_t skipped		= 0; // Steps dropped by skip, or beyond max_catch_up
+			moment	max_jitter;		 // Furthest a wakeup landed from its deadline
+			moment	mean_jitter;
+			moment	max_overrun;	 // Furthest past its deadline wait() was called
+		};
+
+		// Drives a fixed-rate loop. Deadlines are absolute (start + n * period) so per-frame errors never accumulate
+		// into drift, and the wait itself is micro_sleep_until(), which blocks for most of the interval and spins the
+		// learned tail.
+		//
+		//     mu::time::pacer p(mu::time::microseconds(16667));
+		//     for (;;)
+		//     {
+		//         for (uint32_t steps = p.wait(); steps > 0; --steps)
+		//             simulate(p.period());
+		//         render();
+		//     }
+		//
+		// Single thread. Deadlines are in get_now() ticks, so don't switch tick source while a pacer is running.
+		class pacer
+		{
+		public:
+			pacer(const moment& period, const pacer_policy policy = pacer_policy::skip, const uint32_t max_catch_up = 4, const moment& start = now()) noexcept
+				: m_period(std::max<int64_t>(1, period.as_ticks<int64_t>()))
+				, m_next(start.as_ticks<int64_t>() + m_period)
+				, m_policy(policy)
+				, m_max_catch_up(max_catch_up)
+			{
+			}
+
+			// Blocks until the next deadline and returns how many fixed steps to advance: 1 when on time, more under
+			// catch_up after an overrun.
+			auto wait() noexcept -> uint32_t
+			{
+				const int64_t deadline = m_next;
+				int64_t		  t		   = get_now();
+
+				if (t < deadline)
+				{
+					micro_sleep_until(deadline);
+					t = get_now();
+
+					const int64_t jitter = t - deadline;
+					m_jitter_sum += std::abs(jitter);
+					m_stats.max_jitter = std::max(m_stats.max_jitter, ticks(std::abs(jitter)));
+					m_next += m_period;
+					return finish_frame(1);
+				}
+
+				// Late: the deadline passed before we were called.
+				const int64_t overrun = t - deadline;
+				const int64_t missed  = overrun / m_period; // Whole deadlines passed after this one
+				++m_stats.overruns;
+				m_stats.max_overrun = std::max(m_stats.max_overrun, ticks(overrun));
+
+				int64_t steps = 1;
+				if (m_policy == pacer_policy::catch_up)
+				{
+					steps = 1 + std::min<int64_t>(missed, m_max_catch_up);
+				}
+				m_stats.skipped += missed + 1 - steps;
+
+				// Rejoin the grid at the first deadline after now, whatever was run or dropped.
+				m_next += (missed + 1) * m_period;
+				return finish_frame(static_cast<uint32_t>(steps));
+			}
+
+			// Re-anchors the schedule, e.g. after a pause, so the gap isn't reported as an overrun.
+			void reset(const moment& start = now()) noexcept
+			{
+				m_next = start.as_ticks<int64_t>() + m_period;
+			}
+
+			auto period() const noexcept -> moment
+			{
+				return ticks(m_period);
+			}
+
+			auto next_deadline() const noexcept -> moment
+			{
+				return ticks(m_next);
+			}
+
+			// Fixed steps handed out so far; step_count() * period() is the simulated time.
+			auto step_count() const noexcept -> int64_t
+			{
+				return m_steps;
+			}
+
+			auto stats() const noexcept -> pacer_stats
+			{
+				pacer_stats s = m_stats;
+				const int64_t on_time = s.frames - s.overruns;
+				s.mean_jitter		  = on_time > 0 ? ticks(m_jitter_sum / on_time) : moment();
+				return s;
+			}
+
+			void reset_stats() noexcept
+			{
+				m_stats		 = pacer_stats();
+				m_jitter_sum = 0;
+			}
+
+		private:
+			auto finish_frame(const uint32_t steps) noexcept -> uint32_t
+			{
+				++m_stats.frames;
+				m_steps += steps;
+				return steps;
+			}
+
+			int64_t		 m_period;
+			int64_t		 m_next;
+			pacer_policy m_policy;
+			uint32_t	 m_max_catch_up;
+			int64_t		 m_steps	  = 0;
+			int64_t		 m_jitter_sum = 0;
+			pacer_stats	 m_stats;
+		};
+
+		// Token bucket over get_now() ticks, kept as a single atomic "theoretical arrival time" (GCRA), so any
+		// number of threads can draw from it without a lock. Refills at one token per interval up to burst tokens.
+		class rate_limiter
+		{
+		public:
+			rate_limiter(const moment& interval, const uint32_t burst = 1, const moment& start = now()) noexcept
+				: m_interval(std::max<int64_t>(1, interval.as_ticks<int64_t>()))
+				, m_capacity(m_interval * std::max<uint32_t>(1, burst))
+				, m_tat(start.as_ticks<int64_t>())
+			{
+			}
+
+			// Takes n tokens if they're available now.
+			auto try_acquire(const uint32_t n = 1) noexcept -> bool
+			{
+				const int64_t t	   = get_now();
+				const int64_t cost = m_interval * n;
+
+				int64_t tat = m_tat.load(std::memory_order_relaxed);
+				for (;;)
+				{
+					const int64_t next = std::max(tat, t) + cost;
+					if (next - t > m_capacity)
+					{
+						return false;
+					}
+					if (m_tat.compare_exchange_weak(tat, next, std::memory_order_relaxed))
+					{
+						return true;
+					}
+				}
+			}
+
+			// Reserves n tokens and sleeps until they've accrued. Reservations queue in call order, so heavy callers
+			// can't starve others.
+			void acquire(const uint32_t n = 1) noexcept
+			{
+				const int64_t t	   = get_now();
+				const int64_t cost = m_interval * n;
+
+				int64_t tat = m_tat.load(std::memory_order_relaxed);
+				int64_t next;
+				do
+				{
+					next = std::max(tat, t) + cost;
+				}
+				while (!m_tat.compare_exchange_weak(tat, next, std::memory_order_relaxed));
+
+				// The tokens are ours once the bucket would have room for them again.
+				const int64_t ready = next - m_capacity;
+				if (ready > t)
+				{
+					micro_sleep_until(ready);
+				}
+			}
+
+			// How long until n tokens would be available; zero if they are now.
+			auto wait_time(const uint32_t n = 1) const noexcept -> moment
+			{
+				const int64_t t	   = get_now();
+				const int64_t next = std::max(m_tat.load(std::memory_order_relaxed), t) + m_interval * n;
+				return ticks(std::max<int64_t>(0, next - t - m_capacity));
+			}
+
+			auto interval() const noexcept -> moment
+			{
+				return ticks(m_interval);
+			}
+
+		private:
+			const int64_t		 m_interval;
+			const int64_t		 m_capacity;
+			std::atomic<int64_t> m_tat;
+		};
+	} // namespace time
+} // namespace mu
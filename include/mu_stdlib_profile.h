@@ -0,0 +1,138 @@
+#pragma once
+
+#include <mu_stdlib.h>
+
+// Scoped profiling zones. Build with MU_STDLIB_PROFILE defined to 1 (the MU_STDLIB_PROFILE cmake option) to record
+// them; otherwise MU_PROFILE_SCOPE expands to nothing.
+//
+//     void update()
+//     {
+//         MU_PROFILE_SCOPE("update");
+//         ...
+//     }
+//
+//     mu::profile::write_chrome_trace("trace.json"); // open in chrome://tracing or ui.perfetto.dev
+//
+// Zone names must outlive the capture (string literals): only the pointer is recorded. Timestamps are raw
+// mu::time::get_now() ticks, so don't switch tick source (calibrate(), set_tick_source()) mid-capture.
+
+#ifndef MU_STDLIB_PROFILE
+#define MU_STDLIB_PROFILE 0
+#endif
+
+#define MU_PROFILE_CONCAT_IMPL(a, b) a##b
+#define MU_PROFILE_CONCAT(a, b)		 MU_PROFILE_CONCAT_IMPL(a, b)
+
+#if MU_STDLIB_PROFILE
+#define MU_PROFILE_SCOPE(name) const ::mu::profile::zone MU_PROFILE_CONCAT(mu_profile_zone_, __LINE__)(name)
+#else
+#define MU_PROFILE_SCOPE(name) ((void)0)
+#endif
+
+namespace mu
+{
+	namespace profile
+	{
+		namespace details
+		{
+			struct event
+			{
+				const char* name;
+				int64_t		begin;
+				int64_t		end;
+			};
+
+			// Single producer (the owning thread), single consumer (the collector). When full, new zones are dropped
+			// and counted rather than overwriting ones the collector hasn't read.
+			struct alignas(64) thread_ring
+			{
+				static constexpr uint32_t capacity = 1u << 16;
+				static constexpr uint32_t mask	   = capacity - 1;
+
+				alignas(64) std::atomic<uint64_t> head{0};
+				uint64_t cached_tail = 0;
+				alignas(64) std::atomic<uint64_t> tail{0};
+				std::atomic<uint64_t> dropped{0};
+				std::atomic<bool>	  retired{false};
+				uint32_t			  id = 0;
+				event				  events[capacity];
+
+				inline void push(const char* name, const int64_t begin, const int64_t end) noexcept
+				{
+					const uint64_t h = head.load(std::memory_order_relaxed);
+					if (h - cached_tail >= capacity)
+					{
+						cached_tail = tail.load(std::memory_order_acquire);
+						if (h - cached_tail >= capacity)
+						{
+							dropped.store(dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+							return;
+						}
+					}
+					events[h & mask] = {name, begin, end};
+					head.store(h + 1, std::memory_order_release);
+				}
+			};
+
+			inline thread_local thread_ring* t_ring = nullptr;
+
+			// Allocates and registers the calling thread's ring; nullptr if that fails or the thread is exiting.
+			auto register_thread() noexcept -> thread_ring*;
+
+			inline void record(const char* name, const int64_t begin, const int64_t end) noexcept
+			{
+				thread_ring* ring = t_ring;
+				if (ring == nullptr)
+				{
+					ring = register_thread();
+					if (ring == nullptr)
+					{
+						return;
+					}
+				}
+				ring->push(name, begin, end);
+			}
+		} // namespace details
+
+		class zone
+		{
+		public:
+			explicit zone(const char* name) noexcept
+				: m_name(name)
+				, m_begin(time::get_now())
+			{
+			}
+
+			~zone()
+			{
+				details::record(m_name, m_begin, time::get_now());
+			}
+
+			zone(const zone&)				 = delete;
+			auto operator=(const zone&) -> zone& = delete;
+
+		private:
+			const char* m_name;
+			int64_t		m_begin;
+		};
+
+		// Names the calling thread's track in the trace. The string is copied.
+		void set_thread_name(const char* name) noexcept;
+
+		// Moves everything recorded so far out of the per-thread rings into the collector. Rings hold 64k zones each,
+		// so long captures should drain periodically (or use start_collector()) to avoid drops.
+		void drain() noexcept;
+
+		void start_collector(const time::moment& period) noexcept;
+		void stop_collector() noexcept;
+
+		// Zones dropped because a ring was full when they closed.
+		auto dropped() noexcept -> uint64_t;
+
+		// Drains, then writes everything collected as Chrome trace event JSON. The collected zones are kept; clear()
+		// discards them.
+		auto write_chrome_trace(const char* path) noexcept -> bool;
+
+		void clear() noexcept;
+	} // namespace profile
+} // namespace mu
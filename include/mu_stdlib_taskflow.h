@@ -4,9 +4,71 @@
 
 #include <taskflow/taskflow.hpp>
 
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 namespace mu
 {
 	namespace taskflow
 	{
-	}
-}
\ No newline at end of file
+		// Constructs every registered singleton, and everything they declare as dependencies, on executor. Each
+		// singleton is a task that starts as soon as its own dependencies are built, so independent singletons
+		// construct in parallel and a long chain never holds up unrelated ones.
+		//
+		// Teardown order is unchanged: a singleton registers its cleanup when its construction finishes, which is
+		// always after its dependencies', so the cleanup list still destroys in exact reverse-dependency order.
+		// Anything touched lazily later still works as before.
+		inline void initialize_singletons(tf::Executor& executor) noexcept
+		try
+		{
+			std::vector<mu::details::singleton_node*> nodes = mu::details::registered_singletons();
+
+			// Dependencies can be singletons nothing else in the program instantiated, so close over the edges.
+			std::unordered_map<mu::details::singleton_node*, tf::Task> tasks;
+			tf::Taskflow											   flow("mu::singletons");
+			for (size_t i = 0; i < nodes.size(); ++i)
+			{
+				mu::details::singleton_node* node = nodes[i];
+				if (tasks.count(node) != 0)
+				{
+					continue;
+				}
+
+				tasks.emplace(
+					node,
+					flow.emplace(
+							[node]()
+							{
+								node->construct();
+							})
+						.name(std::string(node->name)));
+
+				for (mu::details::singleton_node* dependency : node->dependencies())
+				{
+					if (dependency != nullptr && tasks.count(dependency) == 0)
+					{
+						nodes.push_back(dependency);
+					}
+				}
+			}
+
+			for (const auto& [node, task] : tasks)
+			{
+				for (mu::details::singleton_node* dependency : node->dependencies())
+				{
+					if (dependency != nullptr)
+					{
+						tasks.at(dependency).precede(task);
+					}
+				}
+			}
+
+			executor.run(flow).wait();
+		}
+		catch (...)
+		{
+			// Whatever didn't get built is constructed lazily on first use, as without this call.
+		}
+	} // namespace taskflow
+} // namespace mu
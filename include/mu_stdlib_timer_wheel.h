@@ -0,0 +1,362 @@
+#pragma once
+
+#include <mu_stdlib.h>
+
+#include <algorithm>
+#include <bit>
+#include <memory>
+
+namespace mu
+{
+	namespace time
+	{
+		// Hashed hierarchical timer wheel (Varghese & Lauck) keyed on moment ticks: four levels of 256 slots, each level
+		// covering 256x the span of the one below. Schedule and cancel are O(1), and advance() cascades whole slots
+		// at a time, skipping empty stretches of the finest level with an occupancy bitmap.
+		//
+		// The wheel is owned by one thread, which calls schedule(), cancel() and advance(). Any thread may call
+		// schedule_remote(): nodes come from a fixed-capacity, lock-free pool and are handed to the owner through a
+		// lock-free stack that advance() (or cancel()) drains. No allocation happens after construction.
+		//
+		// The resolution is rounded down to a power of two ticks so slot math is shifts and masks. Deadlines are rounded
+		// up to it, so a timer never fires before its deadline and fires at most one resolution (plus however late
+		// advance() is called) after it.
+		template<typename T = uint64_t>
+		class timer_wheel
+		{
+		public:
+			using handle = uint64_t;
+
+			static constexpr handle invalid_handle = 0;
+
+			timer_wheel(const moment& resolution, const uint32_t capacity, const moment& start = now())
+				: m_nodes(new node[capacity])
+				, m_capacity(capacity)
+				, m_shift(static_cast<uint32_t>(std::bit_width(static_cast<uint64_t>(std::max<int64_t>(1, resolution.as_ticks<int64_t>()))) - 1))
+				, m_current(static_cast<uint64_t>(start.as_ticks<int64_t>()) >> m_shift)
+			{
+				std::fill(std::begin(m_heads), std::end(m_heads), npos);
+				for (uint32_t i = 0; i < capacity; ++i)
+				{
+					m_nodes[i].link.store(i + 1 < capacity ? i + 1 : npos, std::memory_order_relaxed);
+				}
+				m_free_head.store(capacity > 0 ? 0 : npos, std::memory_order_release);
+			}
+
+			timer_wheel(const timer_wheel&)					   = delete;
+			auto operator=(const timer_wheel&) -> timer_wheel& = delete;
+
+			// Owner thread only.
+			auto schedule(const moment& deadline, T payload) noexcept -> handle
+			{
+				const uint32_t index = allocate();
+				if (index == npos)
+				{
+					return invalid_handle;
+				}
+
+				node& n	  = m_nodes[index];
+				n.jiffy	  = deadline_jiffy(deadline);
+				n.payload = std::move(payload);
+				place(index, m_current);
+				++m_size;
+				return make_handle(index, n.generation);
+			}
+
+			// Any thread. The timer joins the wheel at the owner's next advance() or cancel().
+			auto schedule_remote(const moment& deadline, T payload) noexcept -> handle
+			{
+				const uint32_t index = allocate();
+				if (index == npos)
+				{
+					return invalid_handle;
+				}
+
+				node& n	  = m_nodes[index];
+				n.jiffy	  = deadline_jiffy(deadline);
+				n.payload = std::move(payload);
+
+				// Once pushed the owner may fire and recycle the node, so the handle has to be built first.
+				const handle h = make_handle(index, n.generation);
+
+				uint32_t head = m_incoming.load(std::memory_order_relaxed);
+				do
+				{
+					n.link.store(head, std::memory_order_relaxed);
+				}
+				while (!m_incoming.compare_exchange_weak(head, index, std::memory_order_release, std::memory_order_relaxed));
+
+				return h;
+			}
+
+			// Owner thread only. Returns false if the timer already fired or was cancelled.
+			auto cancel(const handle h) noexcept -> bool
+			{
+				const uint32_t index = static_cast<uint32_t>(h);
+				if (h == invalid_handle || index >= m_capacity || m_nodes[index].generation != static_cast<uint32_t>(h >> 32))
+				{
+					return false;
+				}
+
+				drain_incoming();
+				unlink(index);
+				release(index);
+				--m_size;
+				return true;
+			}
+
+			// Owner thread only. Fires every timer whose deadline is at or before now, calling on_expired(T&&) once per
+			// timer. Callbacks may schedule and cancel freely. Returns the number of timers fired.
+			template<typename T_FUNC>
+			auto advance(const moment& now, T_FUNC&& on_expired) noexcept -> size_t
+			{
+				drain_incoming();
+
+				const uint64_t target = static_cast<uint64_t>(now.as_ticks<int64_t>()) >> m_shift;
+				while (m_current < target)
+				{
+					uint64_t next = m_current + 1;
+					if ((next & slot_mask) != 0)
+					{
+						// Jump to the next occupied level 0 slot, or the start of the next rotation if there is none.
+						const uint64_t rotation = next & ~static_cast<uint64_t>(slot_mask);
+						next					= std::min(rotation + next_occupied(0, static_cast<uint32_t>(next & slot_mask)), target);
+					}
+
+					m_current = next;
+					if ((next & slot_mask) == 0)
+					{
+						cascade(next);
+					}
+					expire_slot(static_cast<uint32_t>(next & slot_mask));
+				}
+
+				size_t fired = 0;
+				while (m_heads[expired_list] != npos)
+				{
+					const uint32_t index = m_heads[expired_list];
+					T			   payload(std::move(m_nodes[index].payload));
+					unlink(index);
+					release(index);
+					--m_size;
+					++fired;
+					on_expired(std::move(payload));
+				}
+				return fired;
+			}
+
+			// Timers owned by the wheel, not counting schedule_remote() calls advance() hasn't picked up yet.
+			auto size() const noexcept -> size_t
+			{
+				return m_size;
+			}
+
+			auto capacity() const noexcept -> uint32_t
+			{
+				return m_capacity;
+			}
+
+		private:
+			static constexpr uint32_t npos		   = ~0u;
+			static constexpr uint32_t level_bits   = 8;
+			static constexpr uint32_t level_count  = 4;
+			static constexpr uint32_t slot_count   = 1u << level_bits;
+			static constexpr uint32_t slot_mask	   = slot_count - 1;
+			static constexpr uint32_t expired_list = level_count * slot_count;
+
+			struct node
+			{
+				uint64_t			  jiffy = 0;
+				uint32_t			  prev	= npos;
+				uint32_t			  next	= npos;
+				uint32_t			  list	= npos;
+				uint32_t			  generation = 1;
+				std::atomic<uint32_t> link{npos}; // Free list or incoming stack
+				T					  payload{};
+			};
+
+			static auto make_handle(const uint32_t index, const uint32_t generation) noexcept -> handle
+			{
+				return (static_cast<uint64_t>(generation) << 32) | index;
+			}
+
+			auto deadline_jiffy(const moment& deadline) const noexcept -> uint64_t
+			{
+				const uint64_t ticks = static_cast<uint64_t>(std::max<int64_t>(0, deadline.as_ticks<int64_t>()));
+				return (ticks + ((1ull << m_shift) - 1)) >> m_shift;
+			}
+
+			// Treiber stack with a generation tag in the high half of the head against ABA.
+			auto allocate() noexcept -> uint32_t
+			{
+				uint64_t head = m_free_head.load(std::memory_order_acquire);
+				for (;;)
+				{
+					const uint32_t index = static_cast<uint32_t>(head);
+					if (index == npos)
+					{
+						return npos;
+					}
+					const uint64_t next = (((head >> 32) + 1) << 32) | m_nodes[index].link.load(std::memory_order_relaxed);
+					if (m_free_head.compare_exchange_weak(head, next, std::memory_order_acquire, std::memory_order_acquire))
+					{
+						return index;
+					}
+				}
+			}
+
+			void release(const uint32_t index) noexcept
+			{
+				node& n = m_nodes[index];
+				n.generation = n.generation + 1 == 0 ? 1 : n.generation + 1; // 0 would let index 0 alias invalid_handle
+				n.payload	 = T{};
+
+				uint64_t head = m_free_head.load(std::memory_order_relaxed);
+				uint64_t next;
+				do
+				{
+					n.link.store(static_cast<uint32_t>(head), std::memory_order_relaxed);
+					next = (((head >> 32) + 1) << 32) | index;
+				}
+				while (!m_free_head.compare_exchange_weak(head, next, std::memory_order_release, std::memory_order_relaxed));
+			}
+
+			void drain_incoming() noexcept
+			{
+				uint32_t index = m_incoming.exchange(npos, std::memory_order_acquire);
+				while (index != npos)
+				{
+					node&		   n	= m_nodes[index];
+					const uint32_t next = n.link.load(std::memory_order_relaxed);
+					place(index, m_current);
+					++m_size;
+					index = next;
+				}
+			}
+
+			void link(const uint32_t index, const uint32_t list) noexcept
+			{
+				node& n = m_nodes[index];
+				n.list	= list;
+				n.prev	= npos;
+				n.next	= m_heads[list];
+				if (n.next != npos)
+				{
+					m_nodes[n.next].prev = index;
+				}
+				m_heads[list] = index;
+
+				if (list != expired_list)
+				{
+					m_occupied[list / slot_count][(list % slot_count) / 64] |= 1ull << (list % 64);
+				}
+			}
+
+			void unlink(const uint32_t index) noexcept
+			{
+				node& n = m_nodes[index];
+				if (n.prev != npos)
+				{
+					m_nodes[n.prev].next = n.next;
+				}
+				else
+				{
+					m_heads[n.list] = n.next;
+					if (n.next == npos && n.list != expired_list)
+					{
+						m_occupied[n.list / slot_count][(n.list % slot_count) / 64] &= ~(1ull << (n.list % 64));
+					}
+				}
+				if (n.next != npos)
+				{
+					m_nodes[n.next].prev = n.prev;
+				}
+				n.prev = n.next = n.list = npos;
+			}
+
+			// Picks the level whose span covers the distance from base; anything past the top level's span parks in
+			// its furthest slot and is re-placed each time that slot cascades.
+			void place(const uint32_t index, const uint64_t base) noexcept
+			{
+				const uint64_t jiffy = m_nodes[index].jiffy;
+				if (jiffy <= base)
+				{
+					link(index, expired_list);
+					return;
+				}
+
+				const uint64_t delta = jiffy - base;
+				for (uint32_t level = 0; level < level_count; ++level)
+				{
+					if (delta < (1ull << (level_bits * (level + 1))))
+					{
+						link(index, level * slot_count + static_cast<uint32_t>((jiffy >> (level_bits * level)) & slot_mask));
+						return;
+					}
+				}
+
+				const uint64_t parked = base + (1ull << (level_bits * level_count)) - 1;
+				link(index, (level_count - 1) * slot_count + static_cast<uint32_t>((parked >> (level_bits * (level_count - 1))) & slot_mask));
+			}
+
+			void cascade(const uint64_t jiffy) noexcept
+			{
+				for (uint32_t level = level_count - 1; level > 0; --level)
+				{
+					if ((jiffy & ((1ull << (level_bits * level)) - 1)) != 0)
+					{
+						continue;
+					}
+
+					const uint32_t list = level * slot_count + static_cast<uint32_t>((jiffy >> (level_bits * level)) & slot_mask);
+					while (m_heads[list] != npos)
+					{
+						const uint32_t index = m_heads[list];
+						unlink(index);
+						place(index, jiffy);
+					}
+				}
+			}
+
+			void expire_slot(const uint32_t slot) noexcept
+			{
+				while (m_heads[slot] != npos)
+				{
+					const uint32_t index = m_heads[slot];
+					unlink(index);
+					place(index, m_current);
+				}
+			}
+
+			// First occupied slot at or after from on the given level, or slot_count if there is none.
+			auto next_occupied(const uint32_t level, const uint32_t from) const noexcept -> uint32_t
+			{
+				for (uint32_t word = from / 64; word < slot_count / 64; ++word)
+				{
+					uint64_t bits = m_occupied[level][word];
+					if (word == from / 64)
+					{
+						bits &= ~0ull << (from % 64);
+					}
+					if (bits != 0)
+					{
+						return word * 64 + static_cast<uint32_t>(std::countr_zero(bits));
+					}
+				}
+				return slot_count;
+			}
+
+			std::unique_ptr<node[]> m_nodes;
+			const uint32_t			m_capacity;
+			const uint32_t			m_shift;
+			uint64_t				m_current;
+			size_t					m_size = 0;
+
+			uint32_t m_heads[level_count * slot_count + 1];
+			uint64_t m_occupied[level_count][slot_count / 64] = {};
+
+			alignas(64) std::atomic<uint64_t> m_free_head{npos};
+			alignas(64) std::atomic<uint32_t> m_incoming{npos};
+		};
+	} // namespace time
+} // namespace mu
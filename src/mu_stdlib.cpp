@@ -1,5 +1,10 @@
 #include "mu_stdlib_internal.h"
 
+#include <mu_stdlib_binlog.h>
+#include <mu_stdlib_crash.h>
+#include <mu_stdlib_flight.h>
+#include <mu_stdlib_profile.h>
+
 #pragma warning(push)
 #pragma warning(disable : 4507)
 #include <backward.hpp>
@@ -9,90 +14,668 @@
 
 #include <spdlog/sinks/stdout_sinks.h>
 
+#include <fmt/args.h>
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <deque>
+#include <filesystem>
+#include <future>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
 namespace mu
 {
+	namespace details
+	{
+		// Runs tick() every period on its own thread until stop(). Joined on destruction.
+		class periodic_thread
+		{
+		public:
+			~periodic_thread()
+			{
+				stop();
+			}
+
+			void start(const int64_t period_ns, std::function<void()> tick) noexcept
+			try
+			{
+				stop();
+				m_stop	 = false;
+				m_thread = std::thread(
+					[this, period_ns, tick = std::move(tick)]()
+					{
+						std::unique_lock<std::mutex> lock(m_mutex);
+						while (!m_condition.wait_for(
+							lock,
+							std::chrono::nanoseconds(period_ns),
+							[this]()
+							{
+								return m_stop;
+							}))
+						{
+							tick();
+						}
+					});
+			}
+			catch (...)
+			{
+				// No thread; callers fall back to whatever they do by hand.
+			}
+
+			void stop() noexcept
+			{
+				{
+					std::lock_guard<std::mutex> lock(m_mutex);
+					m_stop = true;
+				}
+				m_condition.notify_all();
+				if (m_thread.joinable())
+				{
+					m_thread.join();
+				}
+			}
+
+		private:
+			std::mutex				m_mutex;
+			std::condition_variable m_condition;
+			std::thread				m_thread;
+			bool					m_stop = false;
+		};
+	} // namespace details
+
 	namespace debug
 	{
-		void log_stack_trace(spdlog::logger& l, spdlog::level::level_enum lvl, unsigned int level_skip) noexcept
-		try
+		namespace details
+		{
+			struct symbol
+			{
+				std::string object;
+				std::string function;
+			};
+
+			// Address -> symbol, shared by every thread and never shrunk: a process has a bounded set of return
+			// addresses, and entries are immutable once published, so lookups only take a shard's read lock. Misses
+			// are resolved under one lock, since backward's resolvers aren't thread-safe.
+			//
+			// The debug info itself is loaded by load() on a thread of its own. Until that finishes, misses are left
+			// unresolved rather than queued behind it.
+			class symbol_cache
+			{
+			public:
+				static auto instance() noexcept -> symbol_cache&
+				{
+					static symbol_cache* c = new symbol_cache();
+					return *c;
+				}
+
+				auto load() noexcept -> std::shared_future<bool>
+				{
+					std::lock_guard<std::mutex> lock(m_load_mutex);
+					if (m_loaded.valid())
+					{
+						return m_loaded;
+					}
+
+					try
+					{
+						std::promise<bool> done;
+						m_loaded = done.get_future().share();
+						std::thread(
+							[this, done = std::move(done)]() mutable
+							{
+								const bool ok = prime();
+								m_ready.store(true, std::memory_order_release);
+								done.set_value(ok);
+							})
+							.detach();
+					}
+					catch (...)
+					{
+						// No thread: misses go back to being resolved (and loaded) by whoever logs them.
+						std::promise<bool> failed;
+						failed.set_value(false);
+						m_loaded = failed.get_future().share();
+						m_ready.store(true, std::memory_order_release);
+					}
+					return m_loaded;
+				}
+
+				// Fills symbols[i] for addresses[i]; nullptr where it couldn't be resolved.
+				void lookup(const void* const* addresses, const symbol** symbols, const size_t count) noexcept
+				{
+					void*  misses[stack_capture::max_frames];
+					size_t miss_count = 0;
+					for (size_t i = 0; i < count; ++i)
+					{
+						symbols[i] = find(addresses[i]);
+						if (symbols[i] == nullptr && miss_count < stack_capture::max_frames)
+						{
+							misses[miss_count++] = const_cast<void*>(addresses[i]);
+						}
+					}
+					m_hits.fetch_add(count - miss_count, std::memory_order_relaxed);
+					if (miss_count == 0)
+					{
+						return;
+					}
+					if (!m_ready.load(std::memory_order_acquire))
+					{
+						load();
+						return;
+					}
+
+					resolve(misses, miss_count);
+					for (size_t i = 0; i < count; ++i)
+					{
+						if (symbols[i] == nullptr)
+						{
+							symbols[i] = find(addresses[i]);
+						}
+					}
+				}
+
+				auto stats() noexcept -> symbol_cache_stats
+				{
+					symbol_cache_stats result;
+					result.hits	  = m_hits.load(std::memory_order_relaxed);
+					result.misses = m_misses.load(std::memory_order_relaxed);
+					for (shard& s : m_shards)
+					{
+						std::shared_lock<std::shared_mutex> lock(s.mutex);
+						result.entries += s.map.size();
+					}
+					return result;
+				}
+
+			private:
+				static constexpr size_t shard_count = 16;
+
+				struct shard
+				{
+					std::shared_mutex							   mutex;
+					std::unordered_map<const void*, const symbol*> map;
+				};
+
+				auto shard_of(const void* address) noexcept -> shard&
+				{
+					return m_shards[(reinterpret_cast<uintptr_t>(address) >> 4) % shard_count];
+				}
+
+				auto find(const void* address) noexcept -> const symbol*
+				{
+					shard&								s = shard_of(address);
+					std::shared_lock<std::shared_mutex> lock(s.mutex);
+					const auto							it = s.map.find(address);
+					return it != s.map.end() ? it->second : nullptr;
+				}
+
+				// Resolving one address of our own makes backward load the executable's debug info, the bulk of the
+				// work; other modules load on their first miss.
+				auto prime() noexcept -> bool
+				try
+				{
+					void*						self = reinterpret_cast<void*>(&symbol_cache::instance);
+					std::lock_guard<std::mutex> lock(m_resolver_mutex);
+					m_resolver.load_addresses(&self, 1);
+					m_resolver.resolve(backward::ResolvedTrace(backward::Trace(self, 0)));
+					return true;
+				}
+				catch (...)
+				{
+					return false;
+				}
+
+				void resolve(void* const* addresses, const size_t count) noexcept
+				try
+				{
+					std::lock_guard<std::mutex> lock(m_resolver_mutex);
+					m_resolver.load_addresses(addresses, static_cast<int>(count));
+					for (size_t i = 0; i < count; ++i)
+					{
+						// Another thread may have resolved it while we waited for the resolver.
+						if (find(addresses[i]) != nullptr)
+						{
+							continue;
+						}
+
+						const backward::ResolvedTrace trace = m_resolver.resolve(backward::ResolvedTrace(backward::Trace(addresses[i], i)));
+						const symbol*				  sym	= new symbol{trace.object_filename, trace.object_function};
+						m_misses.fetch_add(1, std::memory_order_relaxed);
+
+						shard&								s = shard_of(addresses[i]);
+						std::unique_lock<std::shared_mutex> write(s.mutex);
+						s.map.emplace(addresses[i], sym);
+					}
+				}
+				catch (...)
+				{
+					// Out of memory: what wasn't cached is logged as a bare address.
+				}
+
+				std::array<shard, shard_count> m_shards;
+				std::mutex					   m_resolver_mutex;
+				backward::TraceResolver		   m_resolver;
+				std::atomic<uint64_t>		   m_hits{0};
+				std::atomic<uint64_t>		   m_misses{0};
+				std::mutex					   m_load_mutex;
+				std::shared_future<bool>	   m_loaded;
+				std::atomic<bool>			   m_ready{false};
+			};
+		} // namespace details
+
+		auto capture_stack_trace(const unsigned int level_skip) noexcept -> stack_capture
 		{
-			backward::StackTrace stackTrace;
-			stackTrace.load_here();
+			stack_capture capture;
+			try
+			{
+				backward::StackTrace st;
+				st.load_here(stack_capture::max_frames + level_skip + 1);
 
-			backward::TraceResolver resolver;
-			resolver.load_stacktrace(stackTrace);
+				// Discard this level as well
+				for (size_t i = level_skip + 1; i < st.size() && capture.size < stack_capture::max_frames; ++i)
+				{
+					capture.frames[capture.size++] = st[i].addr;
+				}
+			}
+			catch (...)
+			{
+				// Whatever was captured before running out of memory.
+			}
+			return capture;
+		}
+
+		void log_stack_trace(spdlog::logger& l, spdlog::level::level_enum lvl, const stack_capture& trace) noexcept
+		try
+		{
+			const details::symbol* symbols[stack_capture::max_frames];
+			details::symbol_cache::instance().lookup(trace.frames.data(), symbols, trace.size);
 
-			// Discard this level as well
-			for (size_t i = level_skip + 1; i < stackTrace.size(); ++i)
+			for (uint32_t i = 0; i < trace.size; ++i)
 			{
-				backward::ResolvedTrace trace = resolver.resolve(stackTrace[i]);
-				l.log(lvl, fmt::format("{0} {1} [{2}]", trace.object_filename, trace.object_function, trace.addr).c_str());
+				if (symbols[i] != nullptr)
+				{
+					l.log(lvl, "{0} {1} [{2}]", symbols[i]->object, symbols[i]->function, trace.frames[i]);
+				}
+				else
+				{
+					l.log(lvl, "[{0}]", trace.frames[i]);
+				}
 			}
 		}
 		catch (...)
 		{
-			// TODO: log error
-			return;
+			// The logger itself threw, or memory ran out: there is nothing left to report it through.
 		}
 
-		void log_stack_trace(spdlog::logger& l, spdlog::level::level_enum lvl, backward::StackTrace& st, unsigned int level_skip) noexcept
-		try
+		void log_stack_trace(spdlog::logger& l, spdlog::level::level_enum lvl, unsigned int level_skip) noexcept
 		{
-			backward::TraceResolver tr;
-			tr.load_stacktrace(st);
+			log_stack_trace(l, lvl, capture_stack_trace(level_skip + 1));
+		}
 
-			for (size_t i = level_skip; i < st.size(); ++i)
+		void log_stack_trace(spdlog::logger& l, spdlog::level::level_enum lvl, backward::StackTrace& st, unsigned int level_skip) noexcept
+		{
+			stack_capture capture;
+			for (size_t i = level_skip; i < st.size() && capture.size < stack_capture::max_frames; ++i)
 			{
-				backward::ResolvedTrace trace = tr.resolve(st[i]);
-				l.log(lvl, "{0} {1} [{2}]", trace.object_filename, trace.object_function, trace.addr);
+				capture.frames[capture.size++] = st[i].addr;
 			}
+			log_stack_trace(l, lvl, capture);
 		}
-		catch (...)
+
+		auto get_symbol_cache_stats() noexcept -> symbol_cache_stats
+		{
+			return details::symbol_cache::instance().stats();
+		}
+
+		auto load_symbols() noexcept -> std::shared_future<bool>
 		{
-			// TODO: log error
-			return;
+			return details::symbol_cache::instance().load();
 		}
 
 		namespace details
 		{
+			struct logger_config
+			{
+				std::mutex	   mutex;
+				logger_options options;
+				bool		   built = false;
+
+				static auto instance() noexcept -> logger_config&
+				{
+					static logger_config config;
+					return config;
+				}
+
+				auto claim() noexcept -> logger_options
+				{
+					std::lock_guard<std::mutex> lock(mutex);
+					built = true;
+					return options;
+				}
+			};
+
+			// Hands messages to target on a background thread. Producers go through a bounded lock-free MPMC ring
+			// (Vyukov's: each cell carries a sequence number saying whose turn it is), so a log call never takes a
+			// lock or waits on I/O unless the policy is block and the ring is full. It is multi-consumer so that
+			// drop_oldest can evict from the producer side, and flush() can drain on the calling thread.
+			class async_sink final : public spdlog::sinks::sink
+			{
+			public:
+				async_sink(std::shared_ptr<spdlog::sinks::sink> target, const log_overflow_policy policy, const uint32_t capacity)
+					: m_target(std::move(target))
+					, m_policy(policy)
+					, m_mask(std::bit_ceil(std::max<uint32_t>(2, capacity)) - 1)
+					, m_cells(new cell[m_mask + 1])
+				{
+					for (uint64_t i = 0; i <= m_mask; ++i)
+					{
+						m_cells[i].sequence.store(i, std::memory_order_relaxed);
+					}
+					m_thread = std::thread([this]() { run(); });
+				}
+
+				~async_sink() override
+				{
+					{
+						std::lock_guard<std::mutex> lock(m_mutex);
+						m_running.store(false, std::memory_order_release);
+					}
+					m_wake.notify_one();
+					m_thread.join();
+					flush();
+				}
+
+				void log(const spdlog::details::log_msg& msg) override
+				{
+					while (!try_push(msg))
+					{
+						switch (m_policy)
+						{
+						case log_overflow_policy::drop_newest:
+							m_dropped.fetch_add(1, std::memory_order_relaxed);
+							return;
+
+						case log_overflow_policy::drop_oldest:
+							if (try_pop([](const cell&) {}))
+							{
+								m_dropped.fetch_add(1, std::memory_order_relaxed);
+							}
+							break;
+
+						case log_overflow_policy::block:
+							wake();
+							std::this_thread::yield();
+							break;
+						}
+					}
+					wake();
+				}
+
+				void flush() override
+				{
+					while (try_pop([this](const cell& c) { write(c); }))
+					{
+					}
+					m_target->flush();
+				}
+
+				void set_pattern(const std::string& pattern) override
+				{
+					m_target->set_pattern(pattern);
+				}
+
+				void set_formatter(std::unique_ptr<spdlog::formatter> sink_formatter) override
+				{
+					m_target->set_formatter(std::move(sink_formatter));
+				}
+
+				auto dropped() const noexcept -> uint64_t
+				{
+					return m_dropped.load(std::memory_order_relaxed);
+				}
+
+			private:
+				struct cell
+				{
+					std::atomic<uint64_t>		  sequence{0};
+					spdlog::level::level_enum	  level = spdlog::level::off;
+					spdlog::log_clock::time_point time;
+					size_t						  thread_id = 0;
+					spdlog::source_loc			  source;
+					spdlog::string_view_t		  logger_name; // Owned by the logger, which outlives its sinks
+					std::string					  payload;	   // Keeps its capacity as the cell is reused
+				};
+
+				auto try_push(const spdlog::details::log_msg& msg) -> bool
+				{
+					uint64_t pos = m_enqueue.load(std::memory_order_relaxed);
+					cell*	 c;
+					for (;;)
+					{
+						c				   = &m_cells[pos & m_mask];
+						const int64_t diff = static_cast<int64_t>(c->sequence.load(std::memory_order_acquire) - pos);
+						if (diff == 0)
+						{
+							if (m_enqueue.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+							{
+								break;
+							}
+						}
+						else if (diff < 0)
+						{
+							return false; // Full
+						}
+						else
+						{
+							pos = m_enqueue.load(std::memory_order_relaxed);
+						}
+					}
+
+					c->level	   = msg.level;
+					c->time		   = msg.time;
+					c->thread_id   = msg.thread_id;
+					c->source	   = msg.source;
+					c->logger_name = msg.logger_name;
+					try
+					{
+						c->payload.assign(msg.payload.data(), msg.payload.size());
+					}
+					catch (...)
+					{
+						// The slot is claimed and has to be published either way.
+						c->payload.clear();
+						m_dropped.fetch_add(1, std::memory_order_relaxed);
+					}
+					c->sequence.store(pos + 1, std::memory_order_release);
+					return true;
+				}
+
+				template<typename T_FUNC>
+				auto try_pop(T_FUNC&& func) -> bool
+				{
+					uint64_t pos = m_dequeue.load(std::memory_order_relaxed);
+					cell*	 c;
+					for (;;)
+					{
+						c				   = &m_cells[pos & m_mask];
+						const int64_t diff = static_cast<int64_t>(c->sequence.load(std::memory_order_acquire) - (pos + 1));
+						if (diff == 0)
+						{
+							if (m_dequeue.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+							{
+								break;
+							}
+						}
+						else if (diff < 0)
+						{
+							return false; // Empty
+						}
+						else
+						{
+							pos = m_dequeue.load(std::memory_order_relaxed);
+						}
+					}
+
+					func(*c);
+					c->sequence.store(pos + m_mask + 1, std::memory_order_release);
+					return true;
+				}
+
+				void write(const cell& c)
+				{
+					spdlog::details::log_msg msg(c.time, c.source, c.logger_name, c.level, spdlog::string_view_t(c.payload.data(), c.payload.size()));
+					msg.thread_id = c.thread_id;
+					m_target->log(msg);
+				}
+
+				void wake() noexcept
+				{
+					// Pairs with the fence in run(): either we see it idle, or it sees our message.
+					std::atomic_thread_fence(std::memory_order_seq_cst);
+					if (m_idle.load(std::memory_order_relaxed))
+					{
+						std::lock_guard<std::mutex> lock(m_mutex);
+						m_wake.notify_one();
+					}
+				}
+
+				void run() noexcept
+				{
+					while (m_running.load(std::memory_order_acquire))
+					{
+						try
+						{
+							bool wrote = false;
+							while (try_pop([this](const cell& c) { write(c); }))
+							{
+								wrote = true;
+							}
+							if (wrote)
+							{
+								m_target->flush();
+								continue;
+							}
+
+							std::unique_lock<std::mutex> lock(m_mutex);
+							m_idle.store(true, std::memory_order_relaxed);
+							std::atomic_thread_fence(std::memory_order_seq_cst);
+							if (m_enqueue.load(std::memory_order_relaxed) == m_dequeue.load(std::memory_order_relaxed) && m_running.load(std::memory_order_relaxed))
+							{
+								m_wake.wait_for(lock, std::chrono::milliseconds(50));
+							}
+							m_idle.store(false, std::memory_order_relaxed);
+						}
+						catch (...)
+						{
+							// A failing target mustn't take the writer down with it.
+						}
+					}
+				}
+
+				std::shared_ptr<spdlog::sinks::sink> m_target;
+				const log_overflow_policy			 m_policy;
+				const uint64_t						 m_mask;
+				std::unique_ptr<cell[]>				 m_cells;
+
+				alignas(64) std::atomic<uint64_t> m_enqueue{0};
+				alignas(64) std::atomic<uint64_t> m_dequeue{0};
+				alignas(64) std::atomic<uint64_t> m_dropped{0};
+				std::atomic<bool> m_idle{false};
+				std::atomic<bool> m_running{true};
+
+				std::mutex				m_mutex;
+				std::condition_variable m_wake;
+				std::thread				m_thread;
+			};
+
 			struct logger_impl : public logger_interface
 			{
-				backward::TraceResolver			m_resolver_ref; // Keep one of these around so the symbols load properly.
 				std::shared_ptr<spdlog::logger> m_stderr_logger;
 				std::shared_ptr<spdlog::logger> m_stdout_logger;
+				std::shared_ptr<async_sink>		m_stderr_async;
+				std::shared_ptr<async_sink>		m_stdout_async;
+				mu::details::periodic_thread	m_suppressed_reporter;
 
 				static inline auto singleton() noexcept -> logger_impl*
 				{
 					return reinterpret_cast<logger_impl*>(logger().get());
 				}
 
-				logger_impl()
+				explicit logger_impl(const logger_options& options)
 				{
-					auto stderr_logger = std::make_shared<spdlog::logger>("stderr", std::make_shared<spdlog::sinks::stderr_sink_mt>());
-					auto stdout_logger = std::make_shared<spdlog::logger>("stdout", std::make_shared<spdlog::sinks::stdout_sink_mt>());
+					// Don't hold up startup (or anything logging) on debug info; traces before it's in are raw addresses.
+					load_symbols();
+
+					std::shared_ptr<spdlog::sinks::sink> stderr_sink = std::make_shared<spdlog::sinks::stderr_sink_mt>();
+					std::shared_ptr<spdlog::sinks::sink> stdout_sink = std::make_shared<spdlog::sinks::stdout_sink_mt>();
+					if (options.async)
+					{
+						m_stderr_async = std::make_shared<async_sink>(stderr_sink, options.overflow, options.queue_capacity);
+						m_stdout_async = std::make_shared<async_sink>(stdout_sink, options.overflow, options.queue_capacity);
+						stderr_sink	   = m_stderr_async;
+						stdout_sink	   = m_stdout_async;
+					}
+
+					auto stderr_logger = std::make_shared<spdlog::logger>("stderr", stderr_sink);
+					auto stdout_logger = std::make_shared<spdlog::logger>("stdout", stdout_sink);
 
 					std::set_terminate(
 						[]() noexcept
 						{
+							// Rethrowing to the handlers below comes back here for an exception none of them takes.
+							static std::atomic<bool> entered{false};
+							if (entered.exchange(true))
+							{
+								std::_Exit(EXIT_FAILURE);
+							}
+
+							MU_FLIGHT("std::terminate");
+							// With crash dumps installed the raw trace is already on disk: don't resolve another one here.
+							const bool dumped = crash::details::on_terminate();
+
 							auto logger_impl = logger_impl::singleton();
 							if (logger_impl)
 							{
 								if (auto logger_ref = logger_impl::singleton()->stderr_logger(); logger_ref)
 								{
-									backward::StackTrace st;
-									st.load_here(64);
+									if (dumped)
+									{
+										logger_ref->log(spdlog::level::critical, "Unhandled exception, crash dump written");
+									}
+									else
+									{
+										backward::StackTrace st;
+										st.load_here(64);
 
-									logger_ref->log(spdlog::level::critical, "Unhandled exception");
-									log_stack_trace(*logger_ref, spdlog::level::critical, st, 1);
+										logger_ref->log(spdlog::level::critical, "Unhandled exception");
+										log_stack_trace(*logger_ref, spdlog::level::critical, st, 1);
+									}
 									logger_ref->flush();
 									logger_ref.reset();
 								}
+								// Async loggers drain their queues here, on this thread, whatever state the writers are in.
+								logger_impl->drain();
+								if (auto logger_ref = logger_impl::singleton()->stdout_logger(); logger_ref)
+								{
+									logger_ref->flush();
+								}
 
 								// Rethrow and try to get some info out of it
 								if (auto x = std::current_exception())
 								{
 									// TODO: concatenate with additional types
-									auto terminate_error_handlers = error_handlers;
+									// Unlimited: after a burst of errors, the fatal one would otherwise go unlogged.
+									auto terminate_error_handlers = mu::details::make_error_handlers(false);
 
 									leaf::try_handle_all(
 										[&]() -> leaf::result<void>
@@ -108,10 +691,21 @@ namespace mu
 
 					m_stderr_logger = stderr_logger;
 					m_stdout_logger = stdout_logger;
+
+					if (options.suppressed_report_period.as_nanoseconds<int64_t>() > 0)
+					{
+						m_suppressed_reporter.start(
+							options.suppressed_report_period.as_nanoseconds<int64_t>(),
+							[this]()
+							{
+								report_suppressed_logs(*m_stderr_logger);
+							});
+					}
 				}
 
 				virtual ~logger_impl()
 				{
+					m_suppressed_reporter.stop();
 					try
 					{
 						m_stderr_logger.reset();
@@ -133,126 +727,3743 @@ namespace mu
 				{
 					return m_stderr_logger;
 				}
+
+				virtual auto dropped_messages() noexcept -> uint64_t
+				{
+					return (m_stderr_async ? m_stderr_async->dropped() : 0) + (m_stdout_async ? m_stdout_async->dropped() : 0);
+				}
+
+				// Pushes out anything buffered outside the spdlog loggers; the terminate handler calls it before
+				// flushing them.
+				virtual void drain() noexcept
+				{
+				}
 			};
 
 		} // namespace details
-	}	  // namespace debug
-} // namespace mu
 
-MU_DEFINE_VIRTUAL_SINGLETON(mu::debug::details::logger_interface, mu::debug::details::logger_impl);
-MU_EXPORT_SINGLETON(mu::debug::logger);
-
-#ifdef _WINDOWS_
-#include <stdexcept>
+		auto configure_logger(const logger_options& options) noexcept -> bool
+		{
+			{
+				auto&						config = details::logger_config::instance();
+				std::lock_guard<std::mutex> lock(config.mutex);
+				if (config.built)
+				{
+					return false;
+				}
+				config.options = options;
+			}
+
+			// MU_BINLOG records nothing until the writer is running, so don't wait for the first spdlog call.
+			if (options.binary)
+			{
+				(void)logger();
+			}
+			return true;
+		}
+
+		namespace details
+		{
+			// Limiters that have suppressed something, newest first. Only ever pushed to: limiters are statics.
+			static std::atomic<log_limiter*> g_limiters{nullptr};
+		} // namespace details
+
+		void log_limiter::enlist(log_limiter* limiter) noexcept
+		{
+			log_limiter* head = details::g_limiters.load(std::memory_order_relaxed);
+			do
+			{
+				limiter->m_next = head;
+			}
+			while (!details::g_limiters.compare_exchange_weak(head, limiter, std::memory_order_release, std::memory_order_relaxed));
+		}
+
+		void report_suppressed_logs(spdlog::logger& l) noexcept
+		try
+		{
+			for (log_limiter* limiter = details::g_limiters.load(std::memory_order_acquire); limiter != nullptr; limiter = limiter->m_next)
+			{
+				if (const uint64_t suppressed = limiter->take_suppressed(); suppressed > 0)
+				{
+					l.log(spdlog::level::warn, "{0}:{1} suppressed {2} messages", limiter->file(), limiter->line(), suppressed);
+				}
+			}
+		}
+		catch (...)
+		{
+			// Counts taken before the failure are lost; the next report carries on.
+		}
+
+		namespace details
+		{
+			// Open addressing over file and line. A slot is claimed once and its limiter never freed: limiters have to
+			// outlive the report list they join.
+			struct error_site_table
+			{
+				static constexpr size_t capacity = 256;
+
+				std::array<std::atomic<log_limiter*>, capacity> slots{};
+				log_limiter										overflow{"(other error sites)", 0};
+			};
+
+			static error_site_table g_error_sites;
+		} // namespace details
+
+		auto error_site_limiter(const char* file, const uint32_t line) noexcept -> log_limiter&
+		{
+			if (file == nullptr)
+			{
+				file = "";
+			}
+
+			uint64_t hash = 0xcbf29ce484222325ull ^ line;
+			for (const char* c = file; *c != '\0'; ++c)
+			{
+				hash = (hash ^ static_cast<unsigned char>(*c)) * 0x100000001b3ull;
+			}
+
+			auto& table = details::g_error_sites;
+			for (size_t i = 0; i < details::error_site_table::capacity; ++i)
+			{
+				std::atomic<log_limiter*>& slot	   = table.slots[(hash + i) & (details::error_site_table::capacity - 1)];
+				log_limiter*			   limiter = slot.load(std::memory_order_acquire);
+				if (limiter == nullptr)
+				{
+					log_limiter* fresh = new (std::nothrow) log_limiter(file, line);
+					if (fresh == nullptr)
+					{
+						return table.overflow;
+					}
+					if (slot.compare_exchange_strong(limiter, fresh, std::memory_order_acq_rel, std::memory_order_acquire))
+					{
+						return *fresh;
+					}
+					delete fresh; // Another thread took the slot; limiter is now its occupant
+				}
+				if (limiter->line() == line && std::strcmp(limiter->file(), file) == 0)
+				{
+					return *limiter;
+				}
+			}
+			return table.overflow;
+		}
+	} // namespace debug
+} // namespace mu
+
+// Defined with the binary logger, further down: the options pick between the two.
+template<>
+auto mu::details::virtual_singleton_factory<mu::debug::details::logger_interface>::create() noexcept -> mu::debug::details::logger_interface*;
+
+template<>
+auto mu::details::virtual_singleton_factory<mu::debug::details::logger_interface>::dependencies() noexcept -> std::span<singleton_node* const>
+{
+	return {};
+}
+
+MU_EXPORT_SINGLETON(mu::debug::logger);
+
+namespace mu
+{
+	namespace details
+	{
+		// Only touched on thread start and exit, so a mutex is fine. Never destroyed: threads can outlive statics.
+		class thread_index_registry
+		{
+		public:
+			auto acquire() noexcept -> uint32_t
+			try
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				if (!m_free.empty())
+				{
+					const uint32_t index = m_free.back();
+					m_free.pop_back();
+					return index;
+				}
+				return m_next++;
+			}
+			catch (...)
+			{
+				return m_overflow.fetch_add(1);
+			}
+
+			void release(const uint32_t index) noexcept
+			try
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				m_free.push_back(index);
+			}
+			catch (...)
+			{
+				// Leaked; the index just won't be reused.
+			}
+
+			static auto instance() noexcept -> thread_index_registry&
+			{
+				static thread_index_registry* registry = new thread_index_registry();
+				return *registry;
+			}
+
+		private:
+			std::mutex			  m_mutex;
+			std::vector<uint32_t> m_free;
+			uint32_t			  m_next = 0;
+			std::atomic<uint32_t> m_overflow{1u << 30};
+		};
+
+		struct thread_index_slot
+		{
+			const uint32_t index = thread_index_registry::instance().acquire();
+
+			~thread_index_slot()
+			{
+				thread_index_registry::instance().release(index);
+			}
+		};
+	} // namespace details
+
+	auto thread_index() noexcept -> uint32_t
+	{
+		static thread_local details::thread_index_slot slot;
+		return slot.index;
+	}
+
+	namespace details
+	{
+		// Filled during static initialization, from whichever translation unit gets there first, so it has to
+		// construct on first use. Never destroyed: singletons are torn down by their own cleanup list.
+		struct singleton_registry
+		{
+			std::mutex					 mutex;
+			std::vector<singleton_node*> nodes;
+
+			static auto instance() noexcept -> singleton_registry&
+			{
+				static singleton_registry* registry = new singleton_registry();
+				return *registry;
+			}
+		};
+
+		auto register_singleton(singleton_node* node) noexcept -> bool
+		try
+		{
+			auto&						registry = singleton_registry::instance();
+			std::lock_guard<std::mutex> lock(registry.mutex);
+			registry.nodes.push_back(node);
+			return true;
+		}
+		catch (...)
+		{
+			return false;
+		}
+
+		auto registered_singletons() noexcept -> std::vector<singleton_node*>
+		try
+		{
+			auto&						registry = singleton_registry::instance();
+			std::lock_guard<std::mutex> lock(registry.mutex);
+			return registry.nodes;
+		}
+		catch (...)
+		{
+			return {};
+		}
+
+		struct epoch_reclaimer
+		{
+			struct retired
+			{
+				void* p;
+				void (*deleter)(void*) noexcept;
+				uint64_t epoch;
+			};
+
+			std::mutex			 mutex;
+			std::vector<retired> pending;
+
+			// Never destroyed: swappable singletons retire into it from the cleanup list.
+			static auto instance() noexcept -> epoch_reclaimer&
+			{
+				static epoch_reclaimer* reclaimer = new epoch_reclaimer();
+				return *reclaimer;
+			}
+
+			// Everything retired at or before the returned epoch is unreachable.
+			static auto safe_epoch() noexcept -> uint64_t
+			{
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+				if (g_epoch_overflow_readers.load(std::memory_order_acquire) != 0)
+				{
+					return 0;
+				}
+
+				uint64_t oldest = UINT64_MAX;
+				for (const epoch_slot& slot : g_epoch_slots)
+				{
+					const uint64_t e = slot.epoch.load(std::memory_order_acquire);
+					if (e != 0)
+					{
+						oldest = std::min(oldest, e);
+					}
+				}
+				return oldest;
+			}
+
+			// Frees what it can and returns how many are still waiting.
+			auto collect() noexcept -> size_t
+			{
+				std::vector<retired> ready;
+				size_t				 remaining;
+				{
+					const uint64_t				safe = safe_epoch();
+					std::lock_guard<std::mutex> lock(mutex);
+					const auto					split = std::stable_partition(pending.begin(), pending.end(), [safe](const retired& r) { return r.epoch > safe; });
+					ready.assign(split, pending.end());
+					pending.erase(split, pending.end());
+					remaining = pending.size();
+				}
+
+				// Outside the lock: a destructor may well retire something itself.
+				for (const retired& r : ready)
+				{
+					r.deleter(r.p);
+				}
+				return remaining;
+			}
+		};
+
+		void epoch_retire(void* p, void (*deleter)(void*) noexcept) noexcept
+		{
+			// Readers that entered before this increment may hold p; any that enter after it can't reach it.
+			const uint64_t epoch = g_epoch.fetch_add(1, std::memory_order_seq_cst) + 1;
+
+			auto& reclaimer = epoch_reclaimer::instance();
+			try
+			{
+				std::lock_guard<std::mutex> lock(reclaimer.mutex);
+				reclaimer.pending.push_back({p, deleter, epoch});
+			}
+			catch (...)
+			{
+				// Nowhere to defer it to: wait it out here instead.
+				while (epoch_reclaimer::safe_epoch() < epoch)
+				{
+					std::this_thread::yield();
+				}
+				deleter(p);
+				return;
+			}
+			reclaimer.collect();
+		}
+
+		// Platform sections below. Returns nullptr on failure; sets huge_pages to whether the region ended up
+		// backed by them.
+		static auto reserve_singleton_region(size_t bytes, bool& huge_pages) noexcept -> void*;
+
+		// One region for the life of the process, reserved on first use. Packed blocks bump up from the base,
+		// isolated ones bump down from the end.
+		class singleton_arena
+		{
+		public:
+			static constexpr size_t cache_line = 64;
+
+			static auto instance() noexcept -> singleton_arena&
+			{
+				static singleton_arena* arena = new singleton_arena();
+				return *arena;
+			}
+
+			auto configure(const size_t capacity, const bool huge_pages) noexcept -> bool
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				if (m_reserved)
+				{
+					return false;
+				}
+				m_capacity	 = capacity & ~(cache_line - 1);
+				m_huge_pages = huge_pages;
+				return true;
+			}
+
+			auto allocate(const size_t size, const size_t alignment, const bool isolated) noexcept -> void*
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				if (!reserve())
+				{
+					return nullptr;
+				}
+
+				if (isolated)
+				{
+					const size_t align = std::max(alignment, cache_line);
+					const size_t bytes = (size + cache_line - 1) & ~(cache_line - 1);
+					if (bytes > m_high)
+					{
+						return nullptr;
+					}
+					const size_t offset = (m_high - bytes) & ~(align - 1);
+					if (offset < m_low)
+					{
+						return nullptr;
+					}
+					m_high = offset;
+					return m_base + offset;
+				}
+
+				const size_t offset = (m_low + alignment - 1) & ~(alignment - 1);
+				if (offset + size > m_high)
+				{
+					return nullptr;
+				}
+				m_low = offset + size;
+				return m_base + offset;
+			}
+
+			auto contains(const void* p) const noexcept -> bool
+			{
+				const char* c = static_cast<const char*>(p);
+				return m_base != nullptr && c >= m_base && c < m_base + m_capacity;
+			}
+
+			auto info() noexcept -> singletons::arena_info
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				return {m_base, m_reserved ? m_capacity : 0, m_low, m_reserved ? m_capacity - m_high : 0, m_reserved && m_huge_pages};
+			}
+
+		private:
+			auto reserve() noexcept -> bool
+			{
+				if (!m_reserved)
+				{
+					m_reserved = true;
+					m_base	   = static_cast<char*>(reserve_singleton_region(m_capacity, m_huge_pages));
+					m_high	   = m_base != nullptr ? m_capacity : 0;
+				}
+				return m_base != nullptr;
+			}
+
+			std::mutex m_mutex;
+			char*	   m_base		= nullptr;
+			size_t	   m_capacity	= 2 * 1024 * 1024;
+			size_t	   m_low		= 0;
+			size_t	   m_high		= 0;
+			bool	   m_huge_pages = false;
+			bool	   m_reserved	= false;
+		};
+
+		auto singleton_arena_allocate(const size_t size, const size_t alignment, const bool isolated) noexcept -> void*
+		{
+			return singleton_arena::instance().allocate(size, alignment, isolated);
+		}
+
+		auto singleton_arena_contains(const void* p) noexcept -> bool
+		{
+			return singleton_arena::instance().contains(p);
+		}
+	} // namespace details
+
+	namespace singletons
+	{
+		auto configure_arena(const size_t capacity, const bool huge_pages) noexcept -> bool
+		{
+			return details::singleton_arena::instance().configure(capacity, huge_pages);
+		}
+
+		auto get_arena_info() noexcept -> arena_info
+		{
+			return details::singleton_arena::instance().info();
+		}
+
+		void reclaim() noexcept
+		{
+			details::epoch_reclaimer::instance().collect();
+		}
+
+		void synchronize() noexcept
+		{
+			while (details::epoch_reclaimer::instance().collect() != 0)
+			{
+				std::this_thread::yield();
+			}
+		}
+
+		void prewarm() noexcept
+		{
+			// Each construct() builds its own dependencies first, so registration order doesn't matter.
+			for (details::singleton_node* node : details::registered_singletons())
+			{
+				node->construct();
+			}
+		}
+
+		void prewarm(const std::span<const std::string_view> groups) noexcept
+		{
+			for (details::singleton_node* node : details::registered_singletons())
+			{
+				if (std::find(groups.begin(), groups.end(), node->group) != groups.end())
+				{
+					node->construct();
+				}
+			}
+		}
+
+		auto report() noexcept -> std::vector<report_entry>
+		try
+		{
+			const std::vector<details::singleton_node*> nodes = details::registered_singletons();
+
+			std::unordered_map<const details::singleton_node*, size_t> index_of;
+			for (size_t i = 0; i < nodes.size(); ++i)
+			{
+				index_of.emplace(nodes[i], i);
+			}
+
+			// Longest path by construction cost through the dependency graph, memoized per node. A cycle can't have
+			// been constructed (it would deadlock on the function-local statics), but don't recurse forever on one.
+			enum class state : uint8_t
+			{
+				pending,
+				visiting,
+				done
+			};
+			std::vector<state>	 states(nodes.size(), state::pending);
+			std::vector<int64_t> chain(nodes.size(), 0);
+			std::vector<size_t>	 next(nodes.size(), SIZE_MAX);
+
+			std::function<void(size_t)> visit = [&](const size_t i)
+			{
+				if (states[i] != state::pending)
+				{
+					return;
+				}
+				states[i] = state::visiting;
+
+				int64_t best = 0;
+				for (const details::singleton_node* dependency : nodes[i]->dependencies())
+				{
+					const auto it = index_of.find(dependency);
+					if (it == index_of.end())
+					{
+						continue;
+					}
+					visit(it->second);
+					if (states[it->second] == state::done && chain[it->second] > best)
+					{
+						best	= chain[it->second];
+						next[i] = it->second;
+					}
+				}
+
+				chain[i]  = std::max<int64_t>(0, nodes[i]->construct_ticks.load(std::memory_order_relaxed)) + best;
+				states[i] = state::done;
+			};
+
+			std::vector<report_entry> entries;
+			entries.reserve(nodes.size());
+			for (size_t i = 0; i < nodes.size(); ++i)
+			{
+				visit(i);
+
+				const int64_t own = nodes[i]->construct_ticks.load(std::memory_order_relaxed);
+
+				report_entry entry;
+				entry.name		  = nodes[i]->name;
+				entry.group		  = nodes[i]->group;
+				entry.constructed = own >= 0;
+				entry.cost		  = time::ticks(std::max<int64_t>(0, own));
+				entry.chain_cost  = time::ticks(chain[i]);
+				for (const details::singleton_node* dependency : nodes[i]->dependencies())
+				{
+					if (dependency != nullptr)
+					{
+						entry.dependencies.push_back(dependency->name);
+					}
+				}
+				for (size_t j = i; j != SIZE_MAX; j = next[j])
+				{
+					entry.critical_chain.push_back(nodes[j]->name);
+				}
+				entries.push_back(std::move(entry));
+			}
+
+			std::stable_sort(entries.begin(), entries.end(), [](const report_entry& a, const report_entry& b) { return a.chain_cost > b.chain_cost; });
+			return entries;
+		}
+		catch (...)
+		{
+			return {};
+		}
+
+		void log_report(spdlog::logger& l, spdlog::level::level_enum lvl) noexcept
+		try
+		{
+			for (const report_entry& entry : report())
+			{
+				std::string chain;
+				for (const std::string_view name : entry.critical_chain)
+				{
+					if (!chain.empty())
+					{
+						chain += " <- ";
+					}
+					chain += name;
+				}
+
+				if (entry.constructed)
+				{
+					l.log(lvl, "{0} [{1}] {2:.3f} ms, chain {3:.3f} ms: {4}", entry.name, entry.group, entry.cost.as_milliseconds<double>(),
+						  entry.chain_cost.as_milliseconds<double>(), chain);
+				}
+				else
+				{
+					l.log(lvl, "{0} [{1}] not constructed", entry.name, entry.group);
+				}
+			}
+		}
+		catch (...)
+		{
+			// Building a line ran out of memory. Say so on the same logger (spdlog catches its own failures) rather
+			// than leave the report silently short.
+			l.log(spdlog::level::err, "Singleton report cut short");
+		}
+	} // namespace singletons
+} // namespace mu
+
+namespace mu
+{
+	namespace time
+	{
+		namespace details
+		{
+			static const tick_conversions		 s_initial_tick_conversions;
+			std::atomic<const tick_conversions*> s_tick_conversions{&s_initial_tick_conversions};
+
+			static std::mutex s_tick_conversions_mutex;
+			static int64_t	  s_published_frequency = 0;
+
+			// Builds a new table and swaps the pointer. Tables are never written once published, nor freed: a reader may
+			// hold one for as long as it likes. Only an actual change of frequency publishes (at startup, on a change
+			// of tick source, on a drift correction), so the few that are leaked stay few. Returns true so platform
+			// sections can publish their initial frequency from a static initializer.
+			static auto publish_tick_conversions(const int64_t frequency) noexcept -> bool
+			{
+				std::lock_guard<std::mutex> lock(s_tick_conversions_mutex);
+				if (frequency == s_published_frequency)
+				{
+					return true;
+				}
+
+				const tick_conversions* table = new (std::nothrow) tick_conversions{frequency};
+				if (table == nullptr)
+				{
+					return false; // The old table stays in use
+				}
+				s_tick_conversions.store(table, std::memory_order_release);
+				s_published_frequency = frequency;
+				return true;
+			}
+
+			static inline void cpu_relax() noexcept
+			{
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+				_mm_pause();
+#elif defined(__x86_64__) || defined(__i386__)
+				__builtin_ia32_pause();
+#elif defined(__aarch64__)
+				asm volatile("yield");
+#else
+				std::this_thread::yield();
+#endif
+			}
+
+			// Blocks in the kernel until shortly before the deadline and spins the rest of the way. The spin slice tracks
+			// how late blocked wakeups have been (smoothed mean plus four deviations, the way TCP estimates RTO), so
+			// a quiet machine spins for a few microseconds and a noisy one backs off before it misses deadlines. Where
+			// the blocking call is precise, it is capped at a quarter of each interval: every sleep but the shortest
+			// blocks, so the estimate keeps learning and comes back down once the noise passes, instead of spinning
+			// whole intervals on a stale figure. A coarse one (Windows' Sleep(), rounded up to the timer period) keeps
+			// the whole learned slice, which is what absorbs that rounding.
+			class adaptive_sleeper
+			{
+			public:
+				static constexpr int64_t min_spin_slice_ns = 2000;
+				static constexpr int64_t max_spin_slice_ns = 20000000;
+
+				template<typename T_BLOCK_UNTIL>
+				void sleep_until(const int64_t deadline, T_BLOCK_UNTIL&& block_until, const bool precise_blocking = true) noexcept
+				{
+					const tick_conversions& c		 = conversions();
+					const int64_t			interval = c.to_nanoseconds.convert<int64_t>(deadline - get_now());
+					const int64_t			learned	 = m_spin_slice_ns.load(std::memory_order_relaxed);
+					const int64_t			slice	 = precise_blocking ? std::min(learned, interval / 4) : learned;
+
+					const bool blocked = precise_blocking ? slice >= min_spin_slice_ns : slice < interval;
+					if (blocked)
+					{
+						const int64_t wake_target = deadline - c.from_nanoseconds.convert<int64_t>(slice);
+						block_until(wake_target);
+						learn(std::max<int64_t>(0, c.to_nanoseconds.convert<int64_t>(get_now() - wake_target)));
+					}
+
+					int64_t now = get_now();
+					while (now < deadline)
+					{
+						cpu_relax();
+						now = get_now();
+					}
+
+					record(std::max<int64_t>(0, c.to_nanoseconds.convert<int64_t>(now - deadline)), blocked);
+				}
+
+				auto stats() const noexcept -> micro_sleep_stats
+				{
+					micro_sleep_stats result;
+					for (size_t i = 0; i < micro_sleep_stats::bucket_count; ++i)
+					{
+						result.late_histogram[i] = m_late_histogram[i].load(std::memory_order_relaxed);
+					}
+					result.sleeps		   = m_sleeps.load(std::memory_order_relaxed);
+					result.blocked		   = m_blocked.load(std::memory_order_relaxed);
+					result.max_late_ns	   = m_max_late_ns.load(std::memory_order_relaxed);
+					result.spin_slice_ns   = m_spin_slice_ns.load(std::memory_order_relaxed);
+					result.wake_latency_ns = m_latency_mean_ns.load(std::memory_order_relaxed);
+					return result;
+				}
+
+				void reset() noexcept
+				{
+					for (auto& bucket : m_late_histogram)
+					{
+						bucket.store(0, std::memory_order_relaxed);
+					}
+					m_sleeps.store(0, std::memory_order_relaxed);
+					m_blocked.store(0, std::memory_order_relaxed);
+					m_max_late_ns.store(0, std::memory_order_relaxed);
+				}
+
+			private:
+				// Updates race between sleeping threads; a lost update only costs one sample of smoothing.
+				void learn(const int64_t late_ns) noexcept
+				{
+					int64_t		  mean	= m_latency_mean_ns.load(std::memory_order_relaxed);
+					int64_t		  dev	= m_latency_dev_ns.load(std::memory_order_relaxed);
+					const int64_t error = late_ns - mean;
+					mean += error / 8;
+					dev += ((error < 0 ? -error : error) - dev) / 4;
+					m_latency_mean_ns.store(mean, std::memory_order_relaxed);
+					m_latency_dev_ns.store(dev, std::memory_order_relaxed);
+					m_spin_slice_ns.store(std::clamp<int64_t>(mean + 4 * dev, min_spin_slice_ns, max_spin_slice_ns), std::memory_order_relaxed);
+				}
+
+				void record(const int64_t late_ns, const bool blocked) noexcept
+				{
+					const uint64_t late_us = static_cast<uint64_t>(late_ns) / 1000;
+					const size_t   bucket  = std::min<size_t>(std::bit_width(late_us), micro_sleep_stats::bucket_count - 1);
+					m_late_histogram[bucket].fetch_add(1, std::memory_order_relaxed);
+					m_sleeps.fetch_add(1, std::memory_order_relaxed);
+					if (blocked)
+					{
+						m_blocked.fetch_add(1, std::memory_order_relaxed);
+					}
+
+					int64_t max_late = m_max_late_ns.load(std::memory_order_relaxed);
+					while (late_ns > max_late && !m_max_late_ns.compare_exchange_weak(max_late, late_ns, std::memory_order_relaxed))
+					{
+					}
+				}
+
+				// Seeded for Linux's default 50us timer slack; the first few sleeps settle it to the real figure.
+				std::atomic<int64_t> m_latency_mean_ns{50000};
+				std::atomic<int64_t> m_latency_dev_ns{10000};
+				std::atomic<int64_t> m_spin_slice_ns{90000};
+
+				std::array<std::atomic<int64_t>, micro_sleep_stats::bucket_count> m_late_histogram{};
+				std::atomic<int64_t>											  m_sleeps{0};
+				std::atomic<int64_t>											  m_blocked{0};
+				std::atomic<int64_t>											  m_max_late_ns{0};
+			};
+
+			static adaptive_sleeper s_sleeper;
+
+			coarse_clock s_coarse_clock;
+
+			static mu::details::periodic_thread s_coarse_clock_thread;
+		} // namespace details
+
+		auto get_micro_sleep_stats() noexcept -> micro_sleep_stats
+		{
+			return details::s_sleeper.stats();
+		}
+
+		void reset_micro_sleep_stats() noexcept
+		{
+			details::s_sleeper.reset();
+		}
+
+		void start_coarse_clock(const moment& period) noexcept
+		{
+			update_coarse_now();
+			details::s_coarse_clock_thread.start(
+				std::max<int64_t>(1, period.as_nanoseconds<int64_t>()),
+				[]()
+				{
+					update_coarse_now();
+				});
+		}
+
+		void stop_coarse_clock() noexcept
+		{
+			details::s_coarse_clock_thread.stop();
+		}
+	} // namespace time
+} // namespace mu
+
+namespace mu
+{
+	namespace details
+	{
+		// The calling thread's ring for one per-thread recorder (the profiler, MU_BINLOG, the flight recorder), made on
+		// first use and handed back when the thread exits. T_TRAITS supplies ring_type, current() (the thread_local
+		// pointer the recording fast path reads), acquire() and release(). Once the thread's exit has begun,
+		// register_thread() returns nullptr: recording from later destructors is dropped, not registered again.
+		template<typename T_TRAITS>
+		class thread_ring_guard
+		{
+		public:
+			using ring_type = typename T_TRAITS::ring_type;
+
+			static auto register_thread() noexcept -> ring_type*
+			{
+				if (t_exited)
+				{
+					return nullptr;
+				}
+
+				ring_type* ring = T_TRAITS::acquire();
+				if (ring == nullptr)
+				{
+					return nullptr;
+				}
+
+				t_guard.m_ring		= ring;
+				T_TRAITS::current() = ring;
+				return ring;
+			}
+
+			~thread_ring_guard()
+			{
+				T_TRAITS::current() = nullptr;
+				t_exited			= true;
+				if (m_ring != nullptr)
+				{
+					T_TRAITS::release(m_ring);
+				}
+				m_ring = nullptr;
+			}
+
+		private:
+			ring_type* m_ring = nullptr;
+
+			static inline thread_local bool				 t_exited = false;
+			static inline thread_local thread_ring_guard t_guard;
+		};
+
+		// Every thread's single-producer ring for one recorder, read by a single consumer. T_RING has the head, tail,
+		// dropped, retired and id members the profiler's and MU_BINLOG's rings share. A thread's guard retires its
+		// ring on exit, and the drain that empties it deletes it. Kept by recorders that are never destroyed: threads
+		// can record, and exit, after static destruction has started.
+		template<typename T_RING>
+		class thread_ring_registry
+		{
+		public:
+			auto create() noexcept -> T_RING*
+			{
+				T_RING* ring = new (std::nothrow) T_RING();
+				if (ring == nullptr)
+				{
+					return nullptr;
+				}
+
+				try
+				{
+					std::lock_guard<std::mutex> lock(m_mutex);
+					m_rings.push_back(ring);
+					ring->id = m_next_id++;
+					return ring;
+				}
+				catch (...)
+				{
+					delete ring;
+					return nullptr;
+				}
+			}
+
+			static void retire(T_RING* ring) noexcept
+			{
+				ring->retired.store(true, std::memory_order_release);
+			}
+
+			// Calls consume(ring, tail, head) for every ring with what has been committed since the last drain; it
+			// returns how far it read. Retired rings are deleted once read to their head. If consume throws, that
+			// ring's tail stays put and the exception propagates.
+			template<typename T_FUNC>
+			void drain(T_FUNC&& consume)
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				for (size_t i = 0; i < m_rings.size();)
+				{
+					T_RING* ring = m_rings[i];
+
+					// Retired is read before head, so a retired ring is empty once this pass catches up.
+					const bool	   retired = ring->retired.load(std::memory_order_acquire);
+					const uint64_t head	   = ring->head.load(std::memory_order_acquire);
+					const uint64_t tail	   = consume(*ring, ring->tail.load(std::memory_order_relaxed), head);
+					ring->tail.store(tail, std::memory_order_release);
+
+					if (retired && tail == head)
+					{
+						m_retired_dropped += ring->dropped.load(std::memory_order_relaxed);
+						delete ring;
+						m_rings[i] = m_rings.back();
+						m_rings.pop_back();
+					}
+					else
+					{
+						++i;
+					}
+				}
+			}
+
+			auto dropped() noexcept -> uint64_t
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				uint64_t					total = m_retired_dropped;
+				for (const T_RING* ring : m_rings)
+				{
+					total += ring->dropped.load(std::memory_order_relaxed);
+				}
+				return total;
+			}
+
+		private:
+			std::mutex			 m_mutex;
+			std::vector<T_RING*> m_rings;
+			uint32_t			 m_next_id		   = 1;
+			uint64_t			 m_retired_dropped = 0;
+		};
+
+		// The whole of a file, for the decoders of what the recorders wrote.
+		static auto read_file(const char* path, std::vector<std::byte>& data) noexcept -> bool
+		{
+			std::FILE* file = path != nullptr ? std::fopen(path, "rb") : nullptr;
+			if (file == nullptr)
+			{
+				return false;
+			}
+
+			bool ok = true;
+			try
+			{
+				data.clear();
+				std::byte chunk[65536];
+				for (size_t n; (n = std::fread(chunk, 1, sizeof(chunk), file)) > 0;)
+				{
+					data.insert(data.end(), chunk, chunk + n);
+				}
+				ok = std::ferror(file) == 0;
+			}
+			catch (...)
+			{
+				ok = false;
+			}
+			std::fclose(file);
+			return ok;
+		}
+	} // namespace details
+} // namespace mu
+
+namespace mu
+{
+	namespace profile
+	{
+		namespace details
+		{
+			// Owns every thread's ring and everything drained from them. Never destroyed: threads can record, and
+			// exit, after static destruction has started.
+			class collector
+			{
+			public:
+				static auto instance() noexcept -> collector&
+				{
+					static collector* c = new collector();
+					return *c;
+				}
+
+				auto rings() noexcept -> mu::details::thread_ring_registry<thread_ring>&
+				{
+					return m_rings;
+				}
+
+				void set_name(const uint32_t id, const char* name) noexcept
+				try
+				{
+					std::lock_guard<std::mutex> lock(m_mutex);
+					for (auto& n : m_names)
+					{
+						if (n.first == id)
+						{
+							n.second = name;
+							return;
+						}
+					}
+					m_names.emplace_back(id, name);
+				}
+				catch (...)
+				{
+				}
+
+				void drain() noexcept
+				try
+				{
+					std::lock_guard<std::mutex> lock(m_mutex);
+					m_rings.drain(
+						[this](const thread_ring& ring, uint64_t tail, const uint64_t head) -> uint64_t
+						{
+							m_events.reserve(m_events.size() + static_cast<size_t>(head - tail));
+							for (; tail != head; ++tail)
+							{
+								m_events.push_back({ring.events[tail & thread_ring::mask], ring.id});
+							}
+							return tail;
+						});
+				}
+				catch (...)
+				{
+					// Out of memory: whatever wasn't copied stays in the rings for the next drain.
+				}
+
+				auto dropped() noexcept -> uint64_t
+				{
+					return m_rings.dropped();
+				}
+
+				auto write_chrome_trace(const char* path) noexcept -> bool
+				{
+					drain();
+
+					std::lock_guard<std::mutex> lock(m_mutex);
+					std::FILE*					file = std::fopen(path, "wb");
+					if (file == nullptr)
+					{
+						return false;
+					}
+
+					int64_t epoch = INT64_MAX;
+					for (const auto& e : m_events)
+					{
+						epoch = std::min(epoch, e.zone.begin);
+					}
+
+					std::fputs("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n", file);
+					bool first = true;
+					for (const auto& n : m_names)
+					{
+						std::fprintf(file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"", first ? "" : ",\n", n.first);
+						write_escaped(file, n.second.c_str());
+						std::fputs("\"}}", file);
+						first = false;
+					}
+					for (const auto& e : m_events)
+					{
+						std::fprintf(file, "%s{\"name\":\"", first ? "" : ",\n");
+						write_escaped(file, e.zone.name);
+						std::fprintf(
+							file,
+							"\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+							e.thread,
+							time::ticks(e.zone.begin - epoch).as_microseconds<double>(),
+							time::ticks(e.zone.end - e.zone.begin).as_microseconds<double>());
+						first = false;
+					}
+					std::fputs("\n]}\n", file);
+
+					const bool ok = std::ferror(file) == 0;
+					return std::fclose(file) == 0 && ok;
+				}
+
+				void clear() noexcept
+				{
+					std::lock_guard<std::mutex> lock(m_mutex);
+					m_events.clear();
+					m_events.shrink_to_fit();
+				}
+
+			private:
+				struct collected_event
+				{
+					event	 zone;
+					uint32_t thread;
+				};
+
+				static void write_escaped(std::FILE* file, const char* s) noexcept
+				{
+					for (; *s != 0; ++s)
+					{
+						const unsigned char c = static_cast<unsigned char>(*s);
+						if (c == '"' || c == '\\')
+						{
+							std::fputc('\\', file);
+							std::fputc(c, file);
+						}
+						else if (c < 0x20)
+						{
+							std::fprintf(file, "\\u%04x", c);
+						}
+						else
+						{
+							std::fputc(c, file);
+						}
+					}
+				}
+
+				std::mutex									   m_mutex;
+				mu::details::thread_ring_registry<thread_ring> m_rings;
+				std::vector<std::pair<uint32_t, std::string>>  m_names;
+				std::vector<collected_event>				   m_events;
+			};
+
+			// The ring goes back to the collector when the thread exits; zones closed after that are not recorded.
+			struct ring_traits
+			{
+				using ring_type = thread_ring;
+
+				static auto current() noexcept -> thread_ring*&
+				{
+					return t_ring;
+				}
+
+				static auto acquire() noexcept -> thread_ring*
+				{
+					return collector::instance().rings().create();
+				}
+
+				static void release(thread_ring* ring) noexcept
+				{
+					mu::details::thread_ring_registry<thread_ring>::retire(ring);
+				}
+			};
+
+			auto register_thread() noexcept -> thread_ring*
+			{
+				return mu::details::thread_ring_guard<ring_traits>::register_thread();
+			}
+
+			static mu::details::periodic_thread s_collector_thread;
+		} // namespace details
+
+		void set_thread_name(const char* name) noexcept
+		{
+			details::thread_ring* ring = details::t_ring != nullptr ? details::t_ring : details::register_thread();
+			if (ring != nullptr && name != nullptr)
+			{
+				details::collector::instance().set_name(ring->id, name);
+			}
+		}
+
+		void drain() noexcept
+		{
+			details::collector::instance().drain();
+		}
+
+		void start_collector(const time::moment& period) noexcept
+		{
+			details::s_collector_thread.start(
+				std::max<int64_t>(1, period.as_nanoseconds<int64_t>()),
+				[]()
+				{
+					details::collector::instance().drain();
+				});
+		}
+
+		void stop_collector() noexcept
+		{
+			details::s_collector_thread.stop();
+		}
+
+		auto dropped() noexcept -> uint64_t
+		{
+			return details::collector::instance().dropped();
+		}
+
+		auto write_chrome_trace(const char* path) noexcept -> bool
+		{
+			return path != nullptr && details::collector::instance().write_chrome_trace(path);
+		}
+
+		void clear() noexcept
+		{
+			details::collector::instance().clear();
+		}
+	} // namespace profile
+} // namespace mu
+
+namespace mu
+{
+	namespace binlog
+	{
+		namespace details
+		{
+			struct site_info
+			{
+				spdlog::level::level_enum level;
+				std::string				  format;
+				std::string				  file;
+				uint32_t				  line;
+				std::string				  signature;
+			};
+
+			// Owns every thread's ring and the site table. Never destroyed: threads can log, and exit, after static
+			// destruction has started.
+			class registry
+			{
+			public:
+				static auto instance() noexcept -> registry&
+				{
+					static registry* r = new registry();
+					return *r;
+				}
+
+				auto rings() noexcept -> mu::details::thread_ring_registry<thread_ring>&
+				{
+					return m_rings;
+				}
+
+				auto add_site(const source& src, const char* signature, std::atomic<uint32_t>& site) noexcept -> uint32_t
+				try
+				{
+					std::lock_guard<std::mutex> lock(m_sites_mutex);
+					// Another thread may have registered this call site while we waited.
+					if (const uint32_t id = site.load(std::memory_order_relaxed); id != 0)
+					{
+						return id;
+					}
+					m_sites.push_back({src.level, src.format, src.file, src.line, signature});
+					const uint32_t id = static_cast<uint32_t>(m_sites.size());
+					site.store(id, std::memory_order_relaxed);
+					return id;
+				}
+				catch (...)
+				{
+					return 0;
+				}
+
+				auto site(const uint32_t id) noexcept -> const site_info*
+				{
+					std::lock_guard<std::mutex> lock(m_sites_mutex);
+					return id != 0 && id <= m_sites.size() ? &m_sites[id - 1] : nullptr;
+				}
+
+				auto site_count() noexcept -> uint32_t
+				{
+					std::lock_guard<std::mutex> lock(m_sites_mutex);
+					return static_cast<uint32_t>(m_sites.size());
+				}
+
+				// Calls func(thread, record) for every record written so far, oldest first per thread.
+				template<typename T_FUNC>
+				void drain(T_FUNC&& func) noexcept
+				{
+					m_rings.drain(
+						[&func](const thread_ring& ring, uint64_t tail, const uint64_t head) noexcept -> uint64_t
+						{
+							while (tail != head)
+							{
+								const std::byte* at = ring.data + (tail & thread_ring::mask);
+								uint32_t		 word[2];
+								std::memcpy(word, at, sizeof(word));
+								if (word[0] != 0)
+								{
+									func(ring.id, at);
+								}
+								tail += word[1];
+							}
+							return tail;
+						});
+				}
+
+				auto dropped() noexcept -> uint64_t
+				{
+					return m_rings.dropped();
+				}
+
+			private:
+				mu::details::thread_ring_registry<thread_ring> m_rings;
+
+				std::mutex			  m_sites_mutex;
+				std::deque<site_info> m_sites; // Stable addresses for site()
+			};
+
+			// The ring goes back to the registry when the thread exits; records after that are not kept.
+			struct ring_traits
+			{
+				using ring_type = thread_ring;
+
+				static auto current() noexcept -> thread_ring*&
+				{
+					return t_ring;
+				}
+
+				static auto acquire() noexcept -> thread_ring*
+				{
+					return registry::instance().rings().create();
+				}
+
+				static void release(thread_ring* ring) noexcept
+				{
+					mu::details::thread_ring_registry<thread_ring>::retire(ring);
+				}
+			};
+
+			auto register_thread() noexcept -> thread_ring*
+			{
+				return mu::details::thread_ring_guard<ring_traits>::register_thread();
+			}
+
+			auto register_site(const source& src, const char* signature, std::atomic<uint32_t>& site) noexcept -> uint32_t
+			{
+				return registry::instance().add_site(src, signature, site);
+			}
+
+			// Rebuilds a record's arguments from its site's signature and formats them. Shared by the writer thread
+			// and decode_file().
+			static auto format_record(const site_info& site, const std::byte* args, const size_t size, fmt::memory_buffer& out) noexcept -> bool
+			try
+			{
+				fmt::dynamic_format_arg_store<fmt::format_context> store;
+				const std::byte* const							   end = args + size;
+				for (const char code : site.signature)
+				{
+					switch (code)
+					{
+					case 'b':
+					case 'c':
+					{
+						if (args + 1 > end)
+						{
+							return false;
+						}
+						char c;
+						std::memcpy(&c, args, 1);
+						if (code == 'b')
+						{
+							store.push_back(c != 0);
+						}
+						else
+						{
+							store.push_back(c);
+						}
+						args += 1;
+						break;
+					}
+					case 's':
+					{
+						uint32_t length;
+						if (args + sizeof(length) > end)
+						{
+							return false;
+						}
+						std::memcpy(&length, args, sizeof(length));
+						args += sizeof(length);
+						if (args + length > end)
+						{
+							return false;
+						}
+						store.push_back(std::string_view(reinterpret_cast<const char*>(args), length));
+						args += length;
+						break;
+					}
+					default:
+					{
+						uint64_t v;
+						if (args + sizeof(v) > end)
+						{
+							return false;
+						}
+						std::memcpy(&v, args, sizeof(v));
+						args += sizeof(v);
+						if (code == 'i')
+						{
+							store.push_back(static_cast<int64_t>(v));
+						}
+						else if (code == 'u')
+						{
+							store.push_back(v);
+						}
+						else if (code == 'd')
+						{
+							store.push_back(std::bit_cast<double>(v));
+						}
+						else
+						{
+							store.push_back(reinterpret_cast<const void*>(static_cast<uintptr_t>(v)));
+						}
+						break;
+					}
+					}
+				}
+				fmt::vformat_to(std::back_inserter(out), site.format, store);
+				return true;
+			}
+			catch (...)
+			{
+				// Bad format string for these arguments, or out of memory.
+				return false;
+			}
+
+			// Goes straight to the sinks so the message keeps the thread that logged it.
+			static void log_to(spdlog::logger& l, const site_info& site, const std::chrono::system_clock::time_point when, const uint32_t thread, const fmt::memory_buffer& text)
+			{
+				if (!l.should_log(site.level))
+				{
+					return;
+				}
+				spdlog::details::log_msg msg(when, spdlog::source_loc{site.file.c_str(), static_cast<int>(site.line), ""}, l.name(), site.level,
+											 spdlog::string_view_t(text.data(), text.size()));
+				msg.thread_id = thread;
+				for (auto& sink : l.sinks())
+				{
+					if (sink->should_log(site.level))
+					{
+						sink->log(msg);
+					}
+				}
+			}
+
+			// Capture file layout, native byte order:
+			//     file_header, then blocks, each starting with a uint32_t kind:
+			//     site_block:   uint32_t id, int32_t level, uint32_t line, then format, file and signature,
+			//                   each as a uint32_t length and the bytes
+			//     record_block: uint32_t thread, then the record as written to the ring (size in its header)
+			static constexpr char	  file_magic[8] = {'M', 'U', 'B', 'I', 'N', 'L', 'G', '1'};
+			static constexpr uint32_t site_block	= 1;
+			static constexpr uint32_t record_block	= 2;
+
+			struct file_header
+			{
+				char	magic[8];
+				int64_t frequency;	// get_now() ticks per second
+				int64_t base_ticks; // get_now() at base_wall_ns
+				int64_t base_wall_ns;
+			};
+		} // namespace details
+
+		auto dropped() noexcept -> uint64_t
+		{
+			return details::registry::instance().dropped();
+		}
+
+		auto decode_file(const char* path, spdlog::logger& l) noexcept -> bool
+		try
+		{
+			std::vector<std::byte> data;
+			if (!mu::details::read_file(path, data))
+			{
+				return false;
+			}
+
+			const std::byte* at	 = data.data();
+			const std::byte* end = at + data.size();
+
+			details::file_header header;
+			if (data.size() < sizeof(header))
+			{
+				return false;
+			}
+			std::memcpy(&header, at, sizeof(header));
+			at += sizeof(header);
+			if (std::memcmp(header.magic, details::file_magic, sizeof(header.magic)) != 0 || header.frequency <= 0)
+			{
+				return false;
+			}
+
+			auto read_u32 = [&](uint32_t& v) -> bool
+			{
+				if (at + sizeof(v) > end)
+				{
+					return false;
+				}
+				std::memcpy(&v, at, sizeof(v));
+				at += sizeof(v);
+				return true;
+			};
+			auto read_string = [&](std::string& s) -> bool
+			{
+				uint32_t length;
+				if (!read_u32(length) || at + length > end)
+				{
+					return false;
+				}
+				s.assign(reinterpret_cast<const char*>(at), length);
+				at += length;
+				return true;
+			};
+
+			std::unordered_map<uint32_t, details::site_info> sites;
+			fmt::memory_buffer								 text;
+			while (at < end)
+			{
+				uint32_t kind;
+				if (!read_u32(kind))
+				{
+					return false;
+				}
+
+				if (kind == details::site_block)
+				{
+					uint32_t		   id, level;
+					details::site_info site;
+					if (!read_u32(id) || !read_u32(level) || !read_u32(site.line) || !read_string(site.format) || !read_string(site.file) || !read_string(site.signature))
+					{
+						return false;
+					}
+					site.level = static_cast<spdlog::level::level_enum>(level);
+					sites[id]  = std::move(site);
+				}
+				else if (kind == details::record_block)
+				{
+					uint32_t			   thread;
+					details::record_header record;
+					if (!read_u32(thread) || at + sizeof(record) > end)
+					{
+						return false;
+					}
+					std::memcpy(&record, at, sizeof(record));
+					if (record.size < sizeof(record) || at + record.size > end)
+					{
+						return false;
+					}
+
+					const auto site = sites.find(record.site);
+					if (site != sites.end())
+					{
+						text.clear();
+						if (!details::format_record(site->second, at + sizeof(record), record.size - sizeof(record), text))
+						{
+							text.clear();
+							fmt::format_to(std::back_inserter(text), "<undecodable: {0}>", site->second.format);
+						}
+						const long double ns   = static_cast<long double>(record.timestamp - header.base_ticks) * 1e9L / static_cast<long double>(header.frequency);
+						const auto		  wall = std::chrono::nanoseconds(header.base_wall_ns + static_cast<int64_t>(ns));
+						details::log_to(l, site->second, std::chrono::system_clock::time_point(std::chrono::duration_cast<std::chrono::system_clock::duration>(wall)), thread, text);
+					}
+					at += record.size;
+				}
+				else
+				{
+					return false;
+				}
+			}
+			l.flush();
+			return true;
+		}
+		catch (...)
+		{
+			return false;
+		}
+	} // namespace binlog
+
+	namespace details
+	{
+		// Platform sections below. Maps a new file of bytes bytes (zeroed, replacing any existing one) shared, so
+		// stores to the mapping land in the page cache; nullptr on failure.
+		static auto map_file(const char* path, size_t bytes) noexcept -> void*;
+		static void unmap_file(void* p, size_t bytes) noexcept;
+	} // namespace details
+
+	namespace flight
+	{
+		namespace details
+		{
+			static constexpr char ring_magic[8]	 = {'M', 'U', 'F', 'L', 'R', 'N', 'G', '1'};
+			static constexpr char index_magic[8] = {'M', 'U', 'F', 'L', 'I', 'D', 'X', '1'};
+
+			// index.mufl: this, then site_capacity site_entry. Written in place like the rings, so sites and the
+			// thread count survive whatever the rings do.
+			struct index_header
+			{
+				char	 magic[8];
+				uint32_t site_capacity;
+				uint32_t sites;	  // Entries written, site ids being 1-based indices; stored through std::atomic_ref
+				uint32_t threads; // Ring files written, thread-1.mufl up to thread-<threads>.mufl; likewise
+			};
+
+			struct site_entry
+			{
+				uint32_t line;
+				char	 name[60];
+				char	 file[192];
+			};
+
+			static constexpr uint32_t site_capacity = 4096;
+
+			static auto ring_bytes(const uint32_t capacity) noexcept -> size_t
+			{
+				return sizeof(ring_header) + static_cast<size_t>(capacity) * sizeof(event);
+			}
+
+			static void copy_truncated(char* out, const size_t size, const char* s) noexcept
+			{
+				const size_t length = s != nullptr ? std::min(std::strlen(s), size - 1) : 0;
+				std::memcpy(out, s, length);
+				out[length] = '\0';
+			}
+
+			// Never destroyed: threads can record, and exit, after static destruction has started. Mappings are never
+			// unmapped: an exited thread's ring waits in m_free for the next thread to register, so the directory holds
+			// as many ring files as the most threads that were ever recording at once.
+			class recorder
+			{
+			public:
+				static auto instance() noexcept -> recorder&
+				{
+					static recorder* r = new recorder();
+					return *r;
+				}
+
+				auto start(const char* directory, const uint32_t events_per_thread) noexcept -> bool
+				try
+				{
+					std::lock_guard<std::mutex> lock(m_mutex);
+					if (m_index != nullptr || directory == nullptr)
+					{
+						return false;
+					}
+
+					std::error_code error;
+					std::filesystem::create_directories(directory, error);
+					m_directory = directory;
+
+					const std::string path	= m_directory + "/index.mufl";
+					auto*			  index = static_cast<index_header*>(mu::details::map_file(path.c_str(), sizeof(index_header) + site_capacity * sizeof(site_entry)));
+					if (index == nullptr)
+					{
+						return false;
+					}
+					std::memcpy(index->magic, index_magic, sizeof(index->magic));
+					index->site_capacity = site_capacity;
+
+					m_capacity = std::bit_ceil(std::clamp<uint32_t>(events_per_thread, 2, 1u << 30));
+					m_index	   = index;
+					g_running.store(true, std::memory_order_relaxed);
+					return true;
+				}
+				catch (...)
+				{
+					return false;
+				}
+
+				auto add_thread() noexcept -> ring_header*
+				try
+				{
+					std::lock_guard<std::mutex> lock(m_mutex);
+					if (m_index == nullptr)
+					{
+						return nullptr;
+					}
+
+					const auto wall = std::chrono::system_clock::now();
+					if (!m_free.empty())
+					{
+						// Empty it before renaming it, so the events it held are never shown under the new name.
+						ring_header* ring = m_free.back();
+						m_free.pop_back();
+						std::atomic_ref<uint64_t>(ring->head).store(0, std::memory_order_release);
+						ring->name[0]	   = '\0';
+						ring->frequency	   = time::performance_frequency();
+						ring->base_ticks   = time::get_now();
+						ring->base_wall_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(wall.time_since_epoch()).count();
+						return ring;
+					}
+
+					const uint32_t	  thread = m_index->threads + 1;
+					const std::string path	 = m_directory + "/thread-" + std::to_string(thread) + ".mufl";
+					auto*			  ring	 = static_cast<ring_header*>(mu::details::map_file(path.c_str(), ring_bytes(m_capacity)));
+					if (ring == nullptr)
+					{
+						return nullptr;
+					}
+
+					std::memcpy(ring->magic, ring_magic, sizeof(ring->magic));
+					ring->capacity	   = m_capacity;
+					ring->thread	   = thread;
+					ring->frequency	   = time::performance_frequency();
+					ring->base_ticks   = time::get_now();
+					ring->base_wall_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(wall.time_since_epoch()).count();
+					std::atomic_ref<uint32_t>(m_index->threads).store(thread, std::memory_order_release);
+					return ring;
+				}
+				catch (...)
+				{
+					return nullptr;
+				}
+
+				// The ring keeps what its thread recorded until another thread takes it over.
+				void remove_thread(ring_header* ring) noexcept
+				{
+					std::lock_guard<std::mutex> lock(m_mutex);
+					try
+					{
+						m_free.push_back(ring);
+					}
+					catch (...)
+					{
+						// Out of memory: give the mapping up instead; its file stays, and is simply never reused.
+						mu::details::unmap_file(ring, ring_bytes(ring->capacity));
+					}
+				}
+
+				auto add_site(const source& src, std::atomic<uint32_t>& site) noexcept -> uint32_t
+				{
+					std::lock_guard<std::mutex> lock(m_mutex);
+					// Another thread may have registered this call site while we waited.
+					if (const uint32_t id = site.load(std::memory_order_relaxed); id != 0)
+					{
+						return id;
+					}
+
+					const uint32_t count = m_index->sites;
+					if (count == site_capacity)
+					{
+						return 0;
+					}
+					site_entry& entry = reinterpret_cast<site_entry*>(m_index + 1)[count];
+					entry.line		  = src.line;
+					copy_truncated(entry.name, sizeof(entry.name), src.name);
+					copy_truncated(entry.file, sizeof(entry.file), src.file);
+					std::atomic_ref<uint32_t>(m_index->sites).store(count + 1, std::memory_order_release);
+					site.store(count + 1, std::memory_order_relaxed);
+					return count + 1;
+				}
+
+			private:
+				std::mutex				  m_mutex;
+				std::string				  m_directory;
+				index_header*			  m_index	 = nullptr;
+				uint32_t				  m_capacity = 0;
+				std::vector<ring_header*> m_free; // Rings of exited threads, still mapped
+			};
+
+			// The ring goes back to the recorder when its thread exits, for the next thread to register.
+			struct ring_traits
+			{
+				using ring_type = ring_header;
+
+				static auto current() noexcept -> ring_header*&
+				{
+					return t_ring;
+				}
+
+				static auto acquire() noexcept -> ring_header*
+				{
+					return recorder::instance().add_thread();
+				}
+
+				static void release(ring_header* ring) noexcept
+				{
+					recorder::instance().remove_thread(ring);
+				}
+			};
+
+			auto register_thread() noexcept -> ring_header*
+			{
+				return mu::details::thread_ring_guard<ring_traits>::register_thread();
+			}
+
+			auto register_site(const source& src, std::atomic<uint32_t>& site) noexcept -> uint32_t
+			{
+				return recorder::instance().add_site(src, site);
+			}
+		} // namespace details
+
+		auto start(const char* directory, const uint32_t events_per_thread) noexcept -> bool
+		{
+			return details::recorder::instance().start(directory, events_per_thread);
+		}
+
+		void set_thread_name(const char* name) noexcept
+		{
+			if (!details::g_running.load(std::memory_order_relaxed))
+			{
+				return;
+			}
+
+			details::ring_header* ring = details::t_ring;
+			if (ring == nullptr)
+			{
+				ring = details::register_thread();
+				if (ring == nullptr)
+				{
+					return;
+				}
+			}
+			details::copy_truncated(ring->name, sizeof(ring->name), name);
+		}
+
+		auto decode(const char* directory, const time::moment& window, spdlog::logger& l) noexcept -> bool
+		try
+		{
+			if (directory == nullptr)
+			{
+				return false;
+			}
+			const std::string dir = directory;
+
+			std::vector<std::byte> index_data;
+			details::index_header  index;
+			if (!mu::details::read_file((dir + "/index.mufl").c_str(), index_data) || index_data.size() < sizeof(index))
+			{
+				return false;
+			}
+			std::memcpy(&index, index_data.data(), sizeof(index));
+			if (std::memcmp(index.magic, details::index_magic, sizeof(index.magic)) != 0)
+			{
+				return false;
+			}
+			const size_t					 site_count = std::min<size_t>(index.sites, (index_data.size() - sizeof(index)) / sizeof(details::site_entry));
+			std::vector<details::site_entry> sites(site_count);
+			std::memcpy(sites.data(), index_data.data() + sizeof(index), site_count * sizeof(details::site_entry));
+
+			struct decoded
+			{
+				int64_t	 wall_ns;
+				uint32_t thread;
+				uint32_t site;
+				int64_t	 a;
+				int64_t	 b;
+			};
+			std::vector<decoded>	 events;
+			std::vector<std::string> names;
+			std::vector<std::byte>	 data;
+			for (uint32_t thread = 1; thread <= index.threads; ++thread)
+			{
+				details::ring_header header;
+				names.emplace_back();
+				if (!mu::details::read_file((dir + "/thread-" + std::to_string(thread) + ".mufl").c_str(), data) || data.size() < sizeof(header))
+				{
+					continue;
+				}
+				std::memcpy(&header, data.data(), sizeof(header));
+				if (std::memcmp(header.magic, details::ring_magic, sizeof(header.magic)) != 0 || header.frequency <= 0 || std::popcount(header.capacity) != 1 ||
+					data.size() < details::ring_bytes(header.capacity))
+				{
+					continue;
+				}
+				header.name[sizeof(header.name) - 1] = '\0';
+				names.back()						 = header.name;
+
+				// Past a wrap, the oldest slot may be half overwritten by the write that was in flight.
+				const uint64_t		  head	= header.head;
+				const uint64_t		  first = head >= header.capacity ? head - header.capacity + 1 : 0;
+				const details::event* ring	= reinterpret_cast<const details::event*>(data.data() + sizeof(header));
+				for (uint64_t i = first; i < head; ++i)
+				{
+					const details::event e	= ring[i & (header.capacity - 1)];
+					const long double	 ns = static_cast<long double>(e.timestamp - header.base_ticks) * 1e9L / static_cast<long double>(header.frequency);
+					events.push_back({header.base_wall_ns + static_cast<int64_t>(ns), thread, e.site, e.a, e.b});
+				}
+			}
+
+			std::sort(events.begin(), events.end(),
+					  [](const decoded& x, const decoded& y)
+					  {
+						  return x.wall_ns < y.wall_ns;
+					  });
+			const int64_t newest = events.empty() ? 0 : events.back().wall_ns;
+			const int64_t since	 = newest - window.as_nanoseconds<int64_t>();
+
+			for (const decoded& e : events)
+			{
+				if (e.wall_ns < since)
+				{
+					continue;
+				}
+
+				const details::site_entry* site = e.site != 0 && e.site <= sites.size() ? &sites[e.site - 1] : nullptr;
+				const std::string&		   name = names[e.thread - 1];
+				const std::string		   text = fmt::format("[{0}] {1} {2} {3}", name.empty() ? fmt::format("thread {0}", e.thread) : name,
+															  site != nullptr ? site->name : "<unknown site>", e.a, e.b);
+
+				spdlog::details::log_msg msg(std::chrono::system_clock::time_point(std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::nanoseconds(e.wall_ns))),
+											 site != nullptr ? spdlog::source_loc{site->file, static_cast<int>(site->line), ""} : spdlog::source_loc{}, l.name(), spdlog::level::info,
+											 spdlog::string_view_t(text));
+				msg.thread_id = e.thread;
+				for (auto& sink : l.sinks())
+				{
+					if (sink->should_log(spdlog::level::info))
+					{
+						sink->log(msg);
+					}
+				}
+			}
+			l.flush();
+			return true;
+		}
+		catch (...)
+		{
+			return false;
+		}
+	} // namespace flight
+
+	namespace crash
+	{
+		namespace details
+		{
+			static constexpr char	  dump_magic[8] = {'M', 'U', 'C', 'R', 'A', 'S', 'H', '1'};
+			static constexpr uint32_t max_modules	= 512;
+
+			struct module_table
+			{
+				uint32_t	count;
+				dump_module modules[max_modules];
+			};
+
+			// A published module table: never modified or freed, since a crash may be reading it on any thread at any
+			// time. refresh_modules() only publishes a new one when the modules have changed, so few are leaked.
+			struct module_snapshot
+			{
+				uint32_t		   count;
+				const dump_module* modules;
+			};
+
+			// Everything the crash path touches, allocated up front.
+			struct crash_state
+			{
+				std::mutex							mutex; // install() and refresh_modules()
+				bool								handlers_installed = false;
+				char								path[1024];
+				module_table						scratch; // Filled by refresh_modules(), under the mutex
+				std::atomic<const module_snapshot*> modules{nullptr};
+				std::atomic<bool>					installed{false};
+				std::atomic<bool>					written{false}; // Claimed by the first crash
+				std::atomic<bool>					dumped{false};	 // Set once that crash's dump is on disk
+			};
+
+			static crash_state			  g_crash;
+			static std::terminate_handler g_previous_terminate = nullptr;
+
+			// Platform sections below. Only snapshot_modules() and install_handlers() may allocate or lock; the rest
+			// run in signal handlers.
+			static void snapshot_modules(module_table& table) noexcept;
+			static auto install_handlers() noexcept -> bool;
+			static auto prepare_thread_stack() noexcept -> bool;
+			static auto capture_frames(void** frames, uint32_t max) noexcept -> uint32_t;
+			static auto write_dump_file(const char* path, const dump_header& header, const dump_module* modules, uint32_t count) noexcept -> bool;
+
+			static void copy_path(char* out, const size_t size, const char* path) noexcept
+			{
+				size_t i = 0;
+				for (; path != nullptr && path[i] != '\0' && i + 1 < size; ++i)
+				{
+					out[i] = path[i];
+				}
+				out[i] = '\0';
+			}
+
+			// Only one dump per process: whichever crash gets here first, on whichever thread.
+			static auto write_dump(const dump_kind kind, const uint32_t code, const uint64_t fault_address) noexcept -> bool
+			{
+				if (!g_crash.installed.load(std::memory_order_acquire) || g_crash.written.exchange(true, std::memory_order_acq_rel))
+				{
+					return false;
+				}
+
+				void*		   frames[dump_header::max_frames];
+				const uint32_t frame_count = capture_frames(frames, dump_header::max_frames);
+
+				dump_header header{};
+				std::memcpy(header.magic, dump_magic, sizeof(header.magic));
+				header.kind			 = kind;
+				header.code			 = code;
+				header.fault_address = fault_address;
+				header.time			 = static_cast<int64_t>(std::time(nullptr));
+				header.frame_count	 = frame_count;
+				for (uint32_t i = 0; i < frame_count; ++i)
+				{
+					header.frames[i] = reinterpret_cast<uintptr_t>(frames[i]);
+				}
+
+				const module_snapshot* modules = g_crash.modules.load(std::memory_order_acquire);
+				header.module_count			   = modules != nullptr ? modules->count : 0;
+				if (!write_dump_file(g_crash.path, header, modules != nullptr ? modules->modules : nullptr, header.module_count))
+				{
+					return false;
+				}
+				g_crash.dumped.store(true, std::memory_order_release);
+				return true;
+			}
+
+			static void refresh_modules_locked() noexcept
+			{
+				module_table& table = g_crash.scratch;
+				snapshot_modules(table);
+
+				const module_snapshot* current = g_crash.modules.load(std::memory_order_relaxed);
+				if (current != nullptr && current->count == table.count && std::memcmp(current->modules, table.modules, table.count * sizeof(dump_module)) == 0)
+				{
+					return;
+				}
+
+				dump_module* modules = new (std::nothrow) dump_module[std::max<uint32_t>(table.count, 1)];
+				if (modules == nullptr)
+				{
+					return; // The old snapshot stays in use
+				}
+				std::memcpy(modules, table.modules, table.count * sizeof(dump_module));
+				const module_snapshot* snapshot = new (std::nothrow) module_snapshot{table.count, modules};
+				if (snapshot == nullptr)
+				{
+					delete[] modules;
+					return;
+				}
+				g_crash.modules.store(snapshot, std::memory_order_release);
+			}
+
+			[[noreturn]] static void terminate_handler() noexcept
+			{
+				on_terminate();
+				if (g_previous_terminate != nullptr)
+				{
+					g_previous_terminate();
+				}
+				std::abort();
+			}
+
+			auto on_terminate() noexcept -> bool
+			{
+				write_dump(dump_kind::terminate, 0, 0);
+				return g_crash.dumped.load(std::memory_order_acquire);
+			}
+		} // namespace details
+
+		auto dump::find_module(const uint64_t address) const noexcept -> const dump_module*
+		{
+			for (const dump_module& m : modules)
+			{
+				if (address >= m.start && address < m.end)
+				{
+					return &m;
+				}
+			}
+			return nullptr;
+		}
+
+		auto install(const char* path) noexcept -> bool
+		{
+			if (path == nullptr)
+			{
+				return false;
+			}
+
+			std::lock_guard<std::mutex> lock(details::g_crash.mutex);
+			// The crash path reads the path unlocked, so keep it out while the path changes.
+			details::g_crash.installed.store(false, std::memory_order_release);
+			details::copy_path(details::g_crash.path, sizeof(details::g_crash.path), path);
+			details::refresh_modules_locked();
+
+			if (!details::g_crash.handlers_installed)
+			{
+				if (!details::install_handlers())
+				{
+					return false;
+				}
+				details::g_previous_terminate		= std::set_terminate(details::terminate_handler);
+				details::g_crash.handlers_installed = true;
+			}
+			details::prepare_thread_stack();
+			details::g_crash.installed.store(true, std::memory_order_release);
+			return true;
+		}
+
+		auto prepare_thread() noexcept -> bool
+		{
+			return details::prepare_thread_stack();
+		}
+
+		void refresh_modules() noexcept
+		{
+			std::lock_guard<std::mutex> lock(details::g_crash.mutex);
+			details::refresh_modules_locked();
+		}
+
+		auto read_dump(const char* path, dump& out) noexcept -> bool
+		try
+		{
+			std::vector<std::byte> data;
+			if (!mu::details::read_file(path, data))
+			{
+				return false;
+			}
+
+			if (data.size() < sizeof(dump_header))
+			{
+				return false;
+			}
+			std::memcpy(&out.header, data.data(), sizeof(dump_header));
+			if (std::memcmp(out.header.magic, details::dump_magic, sizeof(out.header.magic)) != 0 || out.header.frame_count > dump_header::max_frames ||
+				data.size() < sizeof(dump_header) + static_cast<size_t>(out.header.module_count) * sizeof(dump_module))
+			{
+				return false;
+			}
+			out.modules.resize(out.header.module_count);
+			std::memcpy(out.modules.data(), data.data() + sizeof(dump_header), out.modules.size() * sizeof(dump_module));
+			return true;
+		}
+		catch (...)
+		{
+			return false;
+		}
+	} // namespace crash
+
+	namespace debug
+	{
+		namespace details
+		{
+			// The spdlog loggers as usual, plus a writer that drains the MU_BINLOG rings: formatting each record to
+			// the stdout logger, or copying it verbatim to a capture file for decode_file() / mu_binlog_decode.
+			struct binary_logger_impl : public logger_impl
+			{
+				explicit binary_logger_impl(const logger_options& options)
+					: logger_impl(options)
+					, m_base_ticks(time::get_now())
+					, m_base_wall(std::chrono::system_clock::now())
+				{
+					if (!options.binary_path.empty())
+					{
+						m_file = std::fopen(options.binary_path.c_str(), "wb");
+						if (m_file != nullptr)
+						{
+							binlog::details::file_header header;
+							std::memcpy(header.magic, binlog::details::file_magic, sizeof(header.magic));
+							header.frequency	= time::performance_frequency();
+							header.base_ticks	= m_base_ticks;
+							header.base_wall_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(m_base_wall.time_since_epoch()).count();
+							std::fwrite(&header, sizeof(header), 1, m_file);
+						}
+					}
+
+					binlog::details::g_level.store(spdlog::level::trace, std::memory_order_relaxed);
+					m_writer.start(
+						5000000,
+						[this]()
+						{
+							drain();
+						});
+				}
+
+				~binary_logger_impl() override
+				{
+					binlog::details::g_level.store(spdlog::level::off, std::memory_order_relaxed);
+					m_writer.stop();
+					drain();
+					if (m_file != nullptr)
+					{
+						std::fclose(m_file);
+					}
+				}
+
+				void drain() noexcept override
+				try
+				{
+					std::lock_guard<std::mutex> lock(m_drain_mutex);
+					auto&						registry = binlog::details::registry::instance();
+
+					if (m_file == nullptr)
+					{
+						registry.drain(
+							[this, &registry](const uint32_t thread, const std::byte* at)
+							{
+								binlog::details::record_header record;
+								std::memcpy(&record, at, sizeof(record));
+								const binlog::details::site_info* site = registry.site(record.site);
+								if (site == nullptr || m_stdout_logger == nullptr)
+								{
+									return;
+								}
+
+								m_text.clear();
+								if (!binlog::details::format_record(*site, at + sizeof(record), record.size - sizeof(record), m_text))
+								{
+									m_text.clear();
+									fmt::format_to(std::back_inserter(m_text), "<undecodable: {0}>", site->format);
+								}
+								const auto since = std::chrono::nanoseconds(time::ticks(record.timestamp - m_base_ticks).as_nanoseconds<int64_t>());
+								binlog::details::log_to(*m_stdout_logger, *site, m_base_wall + std::chrono::duration_cast<std::chrono::system_clock::duration>(since), thread, m_text);
+							});
+						if (m_stdout_logger)
+						{
+							m_stdout_logger->flush();
+						}
+						return;
+					}
+
+					// Sites are registered before their first record is written, so collecting the records first and
+					// then writing any new sites ahead of them keeps every record after its site in the file.
+					m_pending.clear();
+					registry.drain(
+						[this](const uint32_t thread, const std::byte* at)
+						{
+							binlog::details::record_header record;
+							std::memcpy(&record, at, sizeof(record));
+							append(&binlog::details::record_block, sizeof(uint32_t));
+							append(&thread, sizeof(thread));
+							append(at, record.size);
+						});
+
+					for (const uint32_t count = registry.site_count(); m_sites_written < count;)
+					{
+						const uint32_t					  id   = ++m_sites_written;
+						const binlog::details::site_info* site = registry.site(id);
+						const int32_t					  lvl  = site->level;
+						write(&binlog::details::site_block, sizeof(uint32_t));
+						write(&id, sizeof(id));
+						write(&lvl, sizeof(lvl));
+						write(&site->line, sizeof(site->line));
+						write_string(site->format);
+						write_string(site->file);
+						write_string(site->signature);
+					}
+					write(m_pending.data(), m_pending.size());
+					std::fflush(m_file);
+				}
+				catch (...)
+				{
+					// Out of memory: what was drained is lost, and counted nowhere.
+				}
+
+			private:
+				void append(const void* p, const size_t size)
+				{
+					const std::byte* b = static_cast<const std::byte*>(p);
+					m_pending.insert(m_pending.end(), b, b + size);
+				}
+
+				void write(const void* p, const size_t size) noexcept
+				{
+					std::fwrite(p, 1, size, m_file);
+				}
+
+				void write_string(const std::string& s) noexcept
+				{
+					const uint32_t length = static_cast<uint32_t>(s.size());
+					write(&length, sizeof(length));
+					write(s.data(), s.size());
+				}
+
+				const int64_t								m_base_ticks;
+				const std::chrono::system_clock::time_point m_base_wall;
+				std::FILE*									m_file			= nullptr;
+				uint32_t									m_sites_written = 0;
+
+				std::mutex					 m_drain_mutex;
+				fmt::memory_buffer			 m_text;
+				std::vector<std::byte>		 m_pending;
+				mu::details::periodic_thread m_writer;
+			};
+		} // namespace details
+	} // namespace debug
+} // namespace mu
+
+template<>
+auto mu::details::virtual_singleton_factory<mu::debug::details::logger_interface>::create() noexcept -> mu::debug::details::logger_interface*
+{
+	const mu::debug::logger_options options = mu::debug::details::logger_config::instance().claim();
+	if (options.binary)
+	{
+		return new mu::debug::details::binary_logger_impl(options);
+	}
+	return new mu::debug::details::logger_impl(options);
+}
+
+#ifdef _WINDOWS_
+#include <stdexcept>
+
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif // #ifndef NOMINMAX
+
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif // #ifndef WIN32_LEAN_AND_MEAN
+
+#include <objbase.h>
+#include <timeapi.h>
+#include <windows.h>
+
+#include <tlhelp32.h>
+
+#include <csignal>
+
+namespace mu
+{
+	// overriding the windows formatmessage handler
+	auto custom_formatmessage(
+		unsigned long dwFlags,
+		const void*	  lpSource,
+		unsigned long dwMessageId,
+		unsigned long dwLanguageId,
+		char*		  lpBuffer,
+		unsigned long nSize,
+		va_list*	  Arguments) noexcept -> unsigned long
+	{
+		return ::FormatMessageA(dwFlags, lpSource, dwMessageId, dwLanguageId, lpBuffer, nSize, Arguments);
+	}
+
+} // namespace mu
+
+namespace mu
+{
+	namespace details
+	{
+		static auto reserve_singleton_region(const size_t bytes, bool& huge_pages) noexcept -> void*
+		{
+			if (huge_pages)
+			{
+				// Needs SeLockMemoryPrivilege; without it this fails and we take normal pages.
+				if (const SIZE_T large = GetLargePageMinimum(); large != 0)
+				{
+					const SIZE_T rounded = (bytes + large - 1) & ~(large - 1);
+					if (void* p = VirtualAlloc(nullptr, rounded, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE))
+					{
+						return p;
+					}
+				}
+			}
+			huge_pages = false;
+			return VirtualAlloc(nullptr, bytes, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+		}
+
+		static auto map_file(const char* path, const size_t bytes) noexcept -> void*
+		{
+			HANDLE file = CreateFileA(path, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+			if (file == INVALID_HANDLE_VALUE)
+			{
+				return nullptr;
+			}
+			// Dirty pages of a file mapping belong to the system cache, not the process, so they outlive it.
+			HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READWRITE, static_cast<DWORD>(static_cast<uint64_t>(bytes) >> 32), static_cast<DWORD>(bytes), nullptr);
+			CloseHandle(file);
+			if (mapping == nullptr)
+			{
+				return nullptr;
+			}
+			void* p = MapViewOfFile(mapping, FILE_MAP_WRITE, 0, 0, bytes);
+			CloseHandle(mapping);
+			return p;
+		}
+
+		static void unmap_file(void* p, const size_t) noexcept
+		{
+			UnmapViewOfFile(p);
+		}
+
+		auto current_cpu() noexcept -> uint32_t
+		{
+			PROCESSOR_NUMBER number;
+			GetCurrentProcessorNumberEx(&number);
+			return static_cast<uint32_t>(number.Group) * 64 + number.Number;
+		}
+
+		auto cpu_count() noexcept -> uint32_t
+		{
+			return GetActiveProcessorCount(ALL_PROCESSOR_GROUPS);
+		}
+	} // namespace details
+
+	namespace crash
+	{
+		namespace details
+		{
+			static LPTOP_LEVEL_EXCEPTION_FILTER g_previous_filter = nullptr;
+
+			static auto WINAPI crash_exception_filter(EXCEPTION_POINTERS* info) -> LONG
+			{
+				const EXCEPTION_RECORD* record = info != nullptr ? info->ExceptionRecord : nullptr;
+				uint64_t				fault  = 0;
+				if (record != nullptr && (record->ExceptionCode == EXCEPTION_ACCESS_VIOLATION || record->ExceptionCode == EXCEPTION_IN_PAGE_ERROR) && record->NumberParameters >= 2)
+				{
+					fault = record->ExceptionInformation[1];
+				}
+				write_dump(dump_kind::exception, record != nullptr ? record->ExceptionCode : 0, fault);
+				return g_previous_filter != nullptr ? g_previous_filter(info) : EXCEPTION_CONTINUE_SEARCH;
+			}
+
+			static void crash_abort_handler(const int sig) noexcept
+			{
+				write_dump(dump_kind::signal, static_cast<uint32_t>(sig), 0);
+				// The CRT has already put the default back: raise again for it.
+				std::raise(sig);
+			}
+
+			static auto install_handlers() noexcept -> bool
+			{
+				g_previous_filter = SetUnhandledExceptionFilter(crash_exception_filter);
+				return std::signal(SIGABRT, crash_abort_handler) != SIG_ERR;
+			}
+
+			// Leaves the filter room to run after a stack overflow on the calling thread.
+			static auto prepare_thread_stack() noexcept -> bool
+			{
+				ULONG guarantee = 64 * 1024;
+				return SetThreadStackGuarantee(&guarantee) != 0;
+			}
+
+			static auto capture_frames(void** frames, const uint32_t max) noexcept -> uint32_t
+			{
+				return CaptureStackBackTrace(0, max, frames, nullptr);
+			}
+
+			static auto write_dump_file(const char* path, const dump_header& header, const dump_module* modules, const uint32_t count) noexcept -> bool
+			{
+				HANDLE file = CreateFileA(path, GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+				if (file == INVALID_HANDLE_VALUE)
+				{
+					return false;
+				}
+				DWORD	   written = 0;
+				const bool ok	   = WriteFile(file, &header, sizeof(header), &written, nullptr) && written == sizeof(header) &&
+								WriteFile(file, modules, static_cast<DWORD>(count * sizeof(dump_module)), &written, nullptr) && written == count * sizeof(dump_module);
+				CloseHandle(file);
+				return ok;
+			}
+
+			// The CodeView record names the PDB, and its GUID and age are what a symbol server matches on.
+			static void read_codeview(const uintptr_t base, dump_module& m) noexcept
+			{
+				const auto* dos = reinterpret_cast<const IMAGE_DOS_HEADER*>(base);
+				if (dos->e_magic != IMAGE_DOS_SIGNATURE)
+				{
+					return;
+				}
+				const auto* nt = reinterpret_cast<const IMAGE_NT_HEADERS*>(base + dos->e_lfanew);
+				if (nt->Signature != IMAGE_NT_SIGNATURE)
+				{
+					return;
+				}
+				m.bias = base - nt->OptionalHeader.ImageBase;
+
+				const IMAGE_DATA_DIRECTORY& directory = nt->OptionalHeader.DataDirectory[IMAGE_DIRECTORY_ENTRY_DEBUG];
+				const auto*					entries	  = reinterpret_cast<const IMAGE_DEBUG_DIRECTORY*>(base + directory.VirtualAddress);
+				for (DWORD i = 0; i < directory.Size / sizeof(IMAGE_DEBUG_DIRECTORY); ++i)
+				{
+					const auto* codeview = reinterpret_cast<const uint8_t*>(base + entries[i].AddressOfRawData);
+					if (entries[i].Type == IMAGE_DEBUG_TYPE_CODEVIEW && entries[i].AddressOfRawData != 0 && entries[i].SizeOfData >= 24 && std::memcmp(codeview, "RSDS", 4) == 0)
+					{
+						m.build_id_size = 20;
+						std::memcpy(m.build_id, codeview + 4, 20);
+						return;
+					}
+				}
+			}
+
+			static void snapshot_modules(module_table& table) noexcept
+			{
+				table.count		= 0;
+				HANDLE snapshot = CreateToolhelp32Snapshot(TH32CS_SNAPMODULE, 0);
+				if (snapshot == INVALID_HANDLE_VALUE)
+				{
+					return;
+				}
+
+				MODULEENTRY32W entry;
+				entry.dwSize = sizeof(entry);
+				for (BOOL more = Module32FirstW(snapshot, &entry); more && table.count < max_modules; more = Module32NextW(snapshot, &entry))
+				{
+					dump_module&	m	 = table.modules[table.count++];
+					m					 = dump_module{};
+					const uintptr_t base = reinterpret_cast<uintptr_t>(entry.modBaseAddr);
+					m.start				 = base;
+					m.end				 = base + entry.modBaseSize;
+					read_codeview(base, m);
+					if (WideCharToMultiByte(CP_UTF8, 0, entry.szExePath, -1, m.path, sizeof(m.path), nullptr, nullptr) == 0)
+					{
+						m.path[0] = '\0';
+					}
+				}
+				CloseHandle(snapshot);
+			}
+		} // namespace details
+	} // namespace crash
+} // namespace mu
+
+namespace mu
+{
+	namespace time
+	{
+		namespace details
+		{
+			static auto get_perf_frequency() noexcept -> int64_t
+			{
+				LARGE_INTEGER perf_freq;
+				QueryPerformanceFrequency(&perf_freq);
+				return perf_freq.QuadPart;
+			}
+
+			int64_t			s_performance_frequency = get_perf_frequency();
+			const bool		s_tick_conversions_ready = publish_tick_conversions(s_performance_frequency);
+			std::atomic_int s_hires_state{0};
+
+		} // namespace details
+
+		auto performance_frequency() noexcept -> int64_t
+		{
+			return details::s_performance_frequency;
+		}
+
+		void calibrate() noexcept
+		{
+			// Nothing to measure: QueryPerformanceCounter already reads the invariant TSC where Windows trusts it, and
+			// Windows calibrates it. Only the frequency is refreshed, for get_calibration_info().
+			details::s_performance_frequency = details::get_perf_frequency();
+			details::publish_tick_conversions(details::s_performance_frequency);
+		}
+
+		void init() noexcept
+		{
+			details::s_performance_frequency = details::get_perf_frequency();
+			details::publish_tick_conversions(details::s_performance_frequency);
+		}
+
+		auto get_now() noexcept -> int64_t
+		{
+			LARGE_INTEGER now;
+			QueryPerformanceCounter(&now);
+			return now.QuadPart;
+		}
+
+		void sleep(const int64_t milliseconds) noexcept
+		{
+			::Sleep(static_cast<DWORD>(milliseconds));
+		}
+
+		void micro_sleep(const int64_t ticks) noexcept
+		{
+			micro_sleep_until(get_now() + ticks);
+		}
+
+		void micro_sleep_until(const int64_t deadline) noexcept
+		{
+			// Sleep() only has millisecond granularity (and less without set_high_resolution_timer()), which the
+			// learned spin slice absorbs: not precise, so it isn't capped.
+			details::s_sleeper.sleep_until(
+				deadline,
+				[](const int64_t wake_target)
+				{
+					if (const int64_t ms = details::conversions().to_milliseconds.convert<int64_t>(wake_target - get_now()); ms > 0)
+					{
+						::Sleep(static_cast<DWORD>(ms));
+					}
+				},
+				false);
+		}
+
+		void set_high_resolution_timer() noexcept
+		{
+			const int prev_state = details::s_hires_state.fetch_add(1);
+			if (prev_state == 0)
+			{
+				timeBeginPeriod(1);
+			}
+		}
+
+		auto release_high_resolution_timer() noexcept -> leaf::result<void>
+		try
+		{
+			const int prev_state = details::s_hires_state.fetch_sub(1);
+			if (prev_state == 1)
+			{
+				timeEndPeriod(1);
+			}
+			else if (prev_state <= 0)
+			{
+				//"Unbalanced HighResolutionTimer reference count"
+				return MU_LEAF_NEW_ERROR(runtime_error::not_specified{});
+			}
+			return {};
+		}
+		catch (...)
+		{
+			return MU_LEAF_NEW_ERROR(runtime_error::not_specified{});
+		}
+
+		auto get_tick_source() noexcept -> tick_source
+		{
+			return tick_source::os_monotonic;
+		}
+
+		auto set_tick_source(tick_source source) noexcept -> bool
+		{
+			// QueryPerformanceCounter already reads the invariant TSC where the OS trusts it.
+			return source == tick_source::os_monotonic;
+		}
+
+		auto get_calibration_info() noexcept -> calibration_info
+		{
+			calibration_info info;
+			info.frequency = details::s_performance_frequency;
+			return info;
+		}
+	} // namespace time
+
+} // namespace mu
+
+// Implement some of the functions and types normally declared in recent Windows SDK.
+#if !defined(_versionhelpers_H_INCLUDED_) && !defined(_INC_VERSIONHELPERS)
+static BOOL IsWindowsVersionOrGreater(WORD major, WORD minor, WORD sp)
+{
+	OSVERSIONINFOEXW osvi = {sizeof(osvi), major, minor, 0, 0, {0}, sp, 0, 0, 0, 0};
+	DWORD			 mask = VER_MAJORVERSION | VER_MINORVERSION | VER_SERVICEPACKMAJOR;
+	ULONGLONG		 cond = ::VerSetConditionMask(0, VER_MAJORVERSION, VER_GREATER_EQUAL);
+	cond				  = ::VerSetConditionMask(cond, VER_MINORVERSION, VER_GREATER_EQUAL);
+	cond				  = ::VerSetConditionMask(cond, VER_SERVICEPACKMAJOR, VER_GREATER_EQUAL);
+	return ::VerifyVersionInfoW(&osvi, mask, cond);
+}
+#define IsWindows8Point1OrGreater() IsWindowsVersionOrGreater(HIBYTE(0x0602), LOBYTE(0x0602), 0) // _WIN32_WINNT_WINBLUE
+#endif
+
+#ifndef DPI_ENUMS_DECLARED
+typedef enum
+{
+	PROCESS_DPI_UNAWARE			  = 0,
+	PROCESS_SYSTEM_DPI_AWARE	  = 1,
+	PROCESS_PER_MONITOR_DPI_AWARE = 2
+} PROCESS_DPI_AWARENESS;
+typedef enum
+{
+	MDT_EFFECTIVE_DPI = 0,
+	MDT_ANGULAR_DPI	  = 1,
+	MDT_RAW_DPI		  = 2,
+	MDT_DEFAULT		  = MDT_EFFECTIVE_DPI
+} MONITOR_DPI_TYPE;
+#endif
+#ifndef _DPI_AWARENESS_CONTEXTS_
+DECLARE_HANDLE(DPI_AWARENESS_CONTEXT);
+#define DPI_AWARENESS_CONTEXT_PER_MONITOR_AWARE (DPI_AWARENESS_CONTEXT) - 3
+#endif
+#ifndef DPI_AWARENESS_CONTEXT_PER_MONITOR_AWARE_V2
+#define DPI_AWARENESS_CONTEXT_PER_MONITOR_AWARE_V2 (DPI_AWARENESS_CONTEXT) - 4
+#endif
+typedef HRESULT(WINAPI* PFN_SetProcessDpiAwareness)(PROCESS_DPI_AWARENESS);						// Shcore.lib + dll, Windows 8.1+
+typedef HRESULT(WINAPI* PFN_GetDpiForMonitor)(HMONITOR, MONITOR_DPI_TYPE, UINT*, UINT*);		// Shcore.lib + dll, Windows 8.1+
+typedef DPI_AWARENESS_CONTEXT(WINAPI* PFN_SetThreadDpiAwarenessContext)(DPI_AWARENESS_CONTEXT); // User32.lib + dll, Windows 10 v1607+ (Creators Update)
+
+#if defined(_MSC_VER) && !defined(NOGDI)
+#pragma comment(lib, "gdi32") // Link with gdi32.lib for GetDeviceCaps()
+#endif
+
+namespace mu
+{
+	// Helper function to enable DPI awareness without setting up a manifest
+	void enable_dpi_awareness() noexcept
+	try
+	{
+		// if (IsWindows10OrGreater()) // This needs a manifest to succeed. Instead we try to grab the function pointer!
+		{
+			static HINSTANCE user32_dll = ::LoadLibraryA("user32.dll"); // Reference counted per-process
+			if (PFN_SetThreadDpiAwarenessContext SetThreadDpiAwarenessContextFn = (PFN_SetThreadDpiAwarenessContext)::GetProcAddress(user32_dll, "SetThreadDpiAwarenessContext"))
+			{
+				SetThreadDpiAwarenessContextFn(DPI_AWARENESS_CONTEXT_PER_MONITOR_AWARE_V2);
+				return;
+			}
+		}
+
+		if (IsWindows8Point1OrGreater())
+		{
+			static HINSTANCE shcore_dll = ::LoadLibraryA("shcore.dll"); // Reference counted per-process
+			if (PFN_SetProcessDpiAwareness SetProcessDpiAwarenessFn = (PFN_SetProcessDpiAwareness)::GetProcAddress(shcore_dll, "SetProcessDpiAwareness"))
+			{
+				SetProcessDpiAwarenessFn(PROCESS_PER_MONITOR_DPI_AWARE);
+				return;
+			}
+		}
+#if _WIN32_WINNT >= 0x0600
+		::SetProcessDPIAware();
+#endif
+	}
+	catch (...)
+	{
+		// TODO: log error
+	}
+
+	auto get_dpi_scale_for_monitor(void* monitor) noexcept -> float
+	try
+	{
+		UINT		xdpi = 96, ydpi = 96;
+		static BOOL bIsWindows8Point1OrGreater = IsWindows8Point1OrGreater();
+		if (bIsWindows8Point1OrGreater)
+		{
+			static HINSTANCE shcore_dll = ::LoadLibraryA("shcore.dll"); // Reference counted per-process
+			if (PFN_GetDpiForMonitor GetDpiForMonitorFn = (PFN_GetDpiForMonitor)::GetProcAddress(shcore_dll, "GetDpiForMonitor"))
+				GetDpiForMonitorFn((HMONITOR)monitor, MDT_EFFECTIVE_DPI, &xdpi, &ydpi);
+		}
+#ifndef NOGDI
+		else
+		{
+			const HDC dc = ::GetDC(NULL);
+			xdpi		 = ::GetDeviceCaps(dc, LOGPIXELSX);
+			ydpi		 = ::GetDeviceCaps(dc, LOGPIXELSY);
+			::ReleaseDC(NULL, dc);
+		}
+#endif
+		assert(xdpi == ydpi); // Please contact me if you hit this assert!
+		return xdpi / 96.0f;
+	}
+	catch (...)
+	{
+		return 1.0f;
+	}
+
+	auto get_dpi_scale_for_hwnd(void* hwnd) noexcept -> float
+	try
+	{
+		HMONITOR monitor = ::MonitorFromWindow((HWND)hwnd, MONITOR_DEFAULTTONEAREST);
+		return get_dpi_scale_for_monitor(monitor);
+	}
+	catch (...)
+	{
+		return 1.0f;
+	}
+} // namespace mu
+
+#endif // #ifdef _WINDOWS_
+
+#ifdef __APPLE__
+#include <cerrno>
+#include <csignal>
+#include <execinfo.h>
+#include <fcntl.h>
+#include <mach-o/dyld.h>
+#include <mach-o/loader.h>
+#include <mach/mach_time.h>
+#include <mach/vm_statistics.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace mu
+{
+	namespace details
+	{
+		static auto reserve_singleton_region(const size_t bytes, bool& huge_pages) noexcept -> void*
+		{
+#if defined(VM_FLAGS_SUPERPAGE_SIZE_2MB)
+			if (huge_pages)
+			{
+				const size_t superpage = 2 * 1024 * 1024;
+				const size_t rounded   = (bytes + superpage - 1) & ~(superpage - 1);
+				void*		 p		   = mmap(nullptr, rounded, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANON, VM_FLAGS_SUPERPAGE_SIZE_2MB, 0);
+				if (p != MAP_FAILED)
+				{
+					return p;
+				}
+			}
+#endif
+			huge_pages = false;
+			void* p	   = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANON, -1, 0);
+			return p != MAP_FAILED ? p : nullptr;
+		}
+
+		static auto map_file(const char* path, const size_t bytes) noexcept -> void*
+		{
+			const int fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+			if (fd < 0)
+			{
+				return nullptr;
+			}
+			// MAP_SHARED stores go straight to the page cache, which outlives the process however it ends.
+			void* p = ftruncate(fd, static_cast<off_t>(bytes)) == 0 ? mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0) : MAP_FAILED;
+			close(fd);
+			return p != MAP_FAILED ? p : nullptr;
+		}
+
+		static void unmap_file(void* p, const size_t bytes) noexcept
+		{
+			munmap(p, bytes);
+		}
+
+		// No public way to ask which core we're on.
+		auto current_cpu() noexcept -> uint32_t
+		{
+			return thread_index();
+		}
+
+		auto cpu_count() noexcept -> uint32_t
+		{
+			return std::thread::hardware_concurrency();
+		}
+	} // namespace details
+
+	namespace crash
+	{
+		namespace details
+		{
+			static constexpr int crash_signals[] = {SIGSEGV, SIGBUS, SIGILL, SIGFPE, SIGABRT};
+			static struct sigaction g_previous_actions[std::size(crash_signals)];
+
+			static void crash_signal_handler(const int sig, siginfo_t* info, void*) noexcept
+			{
+				const bool fault = sig != SIGABRT && info != nullptr;
+				write_dump(dump_kind::signal, static_cast<uint32_t>(sig), fault ? reinterpret_cast<uintptr_t>(info->si_addr) : 0);
+
+				// Hand over to whoever had the signal before (usually the default: a core dump), raising it again for
+				// them in case it wasn't a fault that repeats when we return.
+				for (size_t i = 0; i < std::size(crash_signals); ++i)
+				{
+					if (crash_signals[i] == sig)
+					{
+						sigaction(sig, &g_previous_actions[i], nullptr);
+					}
+				}
+				raise(sig);
+			}
+
+			static auto install_handlers() noexcept -> bool
+			{
+				// backtrace() loads the unwinder on first use, which mustn't happen in a signal handler.
+				void* warm[1];
+				backtrace(warm, 1);
+
+				struct sigaction action{};
+				action.sa_sigaction = crash_signal_handler;
+				action.sa_flags		= SA_SIGINFO | SA_ONSTACK;
+				sigemptyset(&action.sa_mask);
+				for (size_t i = 0; i < std::size(crash_signals); ++i)
+				{
+					if (sigaction(crash_signals[i], &action, &g_previous_actions[i]) != 0)
+					{
+						return false;
+					}
+				}
+				return true;
+			}
+
+			// The handler has to run somewhere when the thread's own stack is what overflowed. Taken off again, and
+			// freed, when the thread exits.
+			struct alternate_stack
+			{
+				static constexpr size_t size = 64 * 1024;
+
+				void* memory = nullptr;
+
+				~alternate_stack()
+				{
+					if (memory != nullptr)
+					{
+						stack_t disable{};
+						disable.ss_flags = SS_DISABLE;
+						sigaltstack(&disable, nullptr);
+						std::free(memory);
+					}
+				}
+			};
+
+			static thread_local alternate_stack t_alternate_stack;
+
+			static auto prepare_thread_stack() noexcept -> bool
+			{
+				if (t_alternate_stack.memory != nullptr)
+				{
+					return true;
+				}
+
+				void* memory = std::malloc(alternate_stack::size);
+				if (memory == nullptr)
+				{
+					return false;
+				}
+				stack_t stack{};
+				stack.ss_sp	  = memory;
+				stack.ss_size = alternate_stack::size;
+				if (sigaltstack(&stack, nullptr) != 0)
+				{
+					std::free(memory);
+					return false;
+				}
+				t_alternate_stack.memory = memory;
+				return true;
+			}
+
+			static auto capture_frames(void** frames, const uint32_t max) noexcept -> uint32_t
+			{
+				const int count = backtrace(frames, static_cast<int>(max));
+				return count > 0 ? static_cast<uint32_t>(count) : 0;
+			}
+
+			static auto write_all(const int fd, const void* data, size_t size) noexcept -> bool
+			{
+				const char* at = static_cast<const char*>(data);
+				while (size > 0)
+				{
+					const ssize_t written = write(fd, at, size);
+					if (written < 0 && errno == EINTR)
+					{
+						continue;
+					}
+					if (written <= 0)
+					{
+						return false;
+					}
+					at += written;
+					size -= static_cast<size_t>(written);
+				}
+				return true;
+			}
+
+			static auto write_dump_file(const char* path, const dump_header& header, const dump_module* modules, const uint32_t count) noexcept -> bool
+			{
+				const int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+				if (fd < 0)
+				{
+					return false;
+				}
+				const bool ok = write_all(fd, &header, sizeof(header)) && write_all(fd, modules, count * sizeof(dump_module));
+				close(fd);
+				return ok;
+			}
+
+			static void snapshot_modules(module_table& table) noexcept
+			{
+				table.count			  = 0;
+				const uint32_t images = _dyld_image_count();
+				for (uint32_t i = 0; i < images && table.count < max_modules; ++i)
+				{
+					const mach_header* header = _dyld_get_image_header(i);
+					if (header == nullptr || header->magic != MH_MAGIC_64)
+					{
+						continue;
+					}
+
+					dump_module&   m	 = table.modules[table.count];
+					m				     = dump_module{};
+					const intptr_t slide = _dyld_get_image_vmaddr_slide(i);
+					uint64_t	   start = UINT64_MAX;
+					uint64_t	   end	 = 0;
+					const char*	   at	 = reinterpret_cast<const char*>(header) + sizeof(mach_header_64);
+					for (uint32_t c = 0; c < header->ncmds; ++c)
+					{
+						load_command command;
+						std::memcpy(&command, at, sizeof(command));
+						if (command.cmd == LC_SEGMENT_64)
+						{
+							segment_command_64 segment;
+							std::memcpy(&segment, at, sizeof(segment));
+							if (std::strncmp(segment.segname, SEG_PAGEZERO, sizeof(segment.segname)) != 0)
+							{
+								start = std::min<uint64_t>(start, segment.vmaddr + slide);
+								end	  = std::max<uint64_t>(end, segment.vmaddr + segment.vmsize + slide);
+							}
+						}
+						else if (command.cmd == LC_UUID)
+						{
+							uuid_command uuid;
+							std::memcpy(&uuid, at, sizeof(uuid));
+							m.build_id_size = sizeof(uuid.uuid);
+							std::memcpy(m.build_id, uuid.uuid, sizeof(uuid.uuid));
+						}
+						at += command.cmdsize;
+					}
+					if (end == 0)
+					{
+						continue;
+					}
+
+					m.start = start;
+					m.end	= end;
+					m.bias	= static_cast<uint64_t>(slide);
+					copy_path(m.path, sizeof(m.path), _dyld_get_image_name(i));
+					++table.count;
+				}
+			}
+		} // namespace details
+	} // namespace crash
+} // namespace mu
+
+namespace mu
+{
+	namespace time
+	{
+		namespace details
+		{
+			static auto get_perf_frequency() noexcept -> int64_t
+			{
+				mach_timebase_info_data_t mach_info;
+				mach_timebase_info(&mach_info);
+				return (mach_info.denom * 1000000000) / mach_info.numer;
+			}
+
+			int64_t			s_performance_frequency = get_perf_frequency();
+			const bool		s_tick_conversions_ready = publish_tick_conversions(s_performance_frequency);
+			uint64_t		s_initial{0};
+			std::atomic_int s_hires_state{0};
+
+		} // namespace details
+
+		auto performance_frequency() noexcept -> int64_t
+		{
+			return details::s_performance_frequency;
+		}
+
+		void calibrate() noexcept
+		{
+			// Nothing to measure: mach_absolute_time() is the kernel's own calibrated counter, and its timebase
+			// doesn't change while the process runs. The frequency is only republished, for get_calibration_info().
+			details::publish_tick_conversions(details::s_performance_frequency);
+		}
+
+		void init() noexcept
+		{
+			details::s_initial = mach_absolute_time();
+			details::publish_tick_conversions(details::s_performance_frequency);
+		}
+
+		auto get_now() noexcept -> int64_t
+		{
+			return mach_absolute_time() - details::s_initial;
+		}
+
+		void sleep(const int64_t milliseconds) noexcept
+		{
+			micro_sleep(((milliseconds * static_cast<long double>(performance_frequency()) * static_cast<long double>(1000ull))));
+		}
+
+		void micro_sleep(const int64_t ticks) noexcept
+		{
+			micro_sleep_until(get_now() + ticks);
+		}
+
+		void micro_sleep_until(const int64_t deadline) noexcept
+		{
+			details::s_sleeper.sleep_until(
+				deadline,
+				[](const int64_t wake_target)
+				{
+					mach_wait_until(static_cast<uint64_t>(wake_target) + details::s_initial);
+				});
+		}
+
+		void set_high_resolution_timer() noexcept
+		{
+			const int prev_state = details::s_hires_state.fetch_add(1);
+			if (prev_state == 0)
+			{
+				// timeBeginPeriod(1);
+			}
+		}
+
+		void release_high_resolution_timer()
+		{
+			const int prev_state = details::s_hires_state.fetch_sub(1);
+			if (prev_state == 1)
+			{
+				// timeEndPeriod(1);
+			}
+			else if (prev_state <= 0)
+			{
+				throw std::runtime_error("Unbalanced HighResolutionTimer reference count");
+			}
+		}
 
-#ifndef NOMINMAX
-#define NOMINMAX
-#endif // #ifndef NOMINMAX
+		auto get_tick_source() noexcept -> tick_source
+		{
+			return tick_source::os_monotonic;
+		}
 
-#ifndef WIN32_LEAN_AND_MEAN
-#define WIN32_LEAN_AND_MEAN
-#endif // #ifndef WIN32_LEAN_AND_MEAN
+		auto set_tick_source(tick_source source) noexcept -> bool
+		{
+			// mach_absolute_time() is the only clock here; on Intel Macs it already reads the invariant TSC.
+			return source == tick_source::os_monotonic;
+		}
 
-#include <objbase.h>
-#include <timeapi.h>
-#include <windows.h>
+		auto get_calibration_info() noexcept -> calibration_info
+		{
+			calibration_info info;
+			info.frequency = details::s_performance_frequency;
+			return info;
+		}
+	} // namespace time
+
+} // namespace mu
 
 namespace mu
 {
-	// overriding the windows formatmessage handler
-	auto custom_formatmessage(
-		unsigned long dwFlags,
-		const void*	  lpSource,
-		unsigned long dwMessageId,
-		unsigned long dwLanguageId,
-		char*		  lpBuffer,
-		unsigned long nSize,
-		va_list*	  Arguments) noexcept -> unsigned long
+	void enable_dpi_awareness() noexcept { }
+
+	auto get_dpi_scale_for_monitor([[maybe_unused]] void* monitor) noexcept -> float
 	{
-		return ::FormatMessageA(dwFlags, lpSource, dwMessageId, dwLanguageId, lpBuffer, nSize, Arguments);
+		return 1.0f;
+	}
+
+	auto get_dpi_scale_for_hwnd([[maybe_unused]] void* hwnd) noexcept -> float
+	{
+		return 1.0f;
 	}
+} // namespace mu
+
+#endif // #ifdef __APPLE__
+
+#ifdef __linux__
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <condition_variable>
+#include <csignal>
+#include <elf.h>
+#include <execinfo.h>
+#include <fcntl.h>
+#include <link.h>
+#include <mutex>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/prctl.h>
+#include <thread>
+#include <time.h>
+#include <unistd.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#include <x86intrin.h>
+#define MU_TIME_HAS_TSC 1
+#else
+#define MU_TIME_HAS_TSC 0
+#endif
+
+namespace mu
+{
+	namespace details
+	{
+		static auto reserve_singleton_region(const size_t bytes, bool& huge_pages) noexcept -> void*
+		{
+			if (huge_pages)
+			{
+				// Explicit huge pages only exist if the admin reserved some (vm.nr_hugepages).
+				const size_t huge_page = 2 * 1024 * 1024;
+				const size_t rounded   = (bytes + huge_page - 1) & ~(huge_page - 1);
+				void*		 p		   = mmap(nullptr, rounded, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+				if (p != MAP_FAILED)
+				{
+					return p;
+				}
+			}
+
+			void* p = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+			if (p == MAP_FAILED)
+			{
+				return nullptr;
+			}
+			// Otherwise ask for transparent huge pages, which the kernel applies if the region qualifies.
+			huge_pages = huge_pages && madvise(p, bytes, MADV_HUGEPAGE) == 0;
+			return p;
+		}
+
+		static auto map_file(const char* path, const size_t bytes) noexcept -> void*
+		{
+			const int fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+			if (fd < 0)
+			{
+				return nullptr;
+			}
+			// MAP_SHARED stores go straight to the page cache, which outlives the process however it ends.
+			void* p = ftruncate(fd, static_cast<off_t>(bytes)) == 0 ? mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0) : MAP_FAILED;
+			close(fd);
+			return p != MAP_FAILED ? p : nullptr;
+		}
+
+		static void unmap_file(void* p, const size_t bytes) noexcept
+		{
+			munmap(p, bytes);
+		}
+
+		// glibc 2.35+ answers sched_getcpu() from the rseq area the kernel keeps current for each thread, so this is
+		// a load; older versions go through the vDSO getcpu, which is still no syscall.
+		auto current_cpu() noexcept -> uint32_t
+		{
+			const int cpu = sched_getcpu();
+			return cpu >= 0 ? static_cast<uint32_t>(cpu) : thread_index();
+		}
+
+		auto cpu_count() noexcept -> uint32_t
+		{
+			// Configured rather than online, so CPU numbers stay in range as cores come and go.
+			const long count = sysconf(_SC_NPROCESSORS_CONF);
+			return count > 0 ? static_cast<uint32_t>(count) : std::thread::hardware_concurrency();
+		}
+	} // namespace details
+
+	namespace crash
+	{
+		namespace details
+		{
+			static constexpr int crash_signals[] = {SIGSEGV, SIGBUS, SIGILL, SIGFPE, SIGABRT};
+			static struct sigaction g_previous_actions[std::size(crash_signals)];
+
+			static void crash_signal_handler(const int sig, siginfo_t* info, void*) noexcept
+			{
+				const bool fault = sig != SIGABRT && info != nullptr;
+				write_dump(dump_kind::signal, static_cast<uint32_t>(sig), fault ? reinterpret_cast<uintptr_t>(info->si_addr) : 0);
+
+				// Hand over to whoever had the signal before (usually the default: a core dump), raising it again for
+				// them in case it wasn't a fault that repeats when we return.
+				for (size_t i = 0; i < std::size(crash_signals); ++i)
+				{
+					if (crash_signals[i] == sig)
+					{
+						sigaction(sig, &g_previous_actions[i], nullptr);
+					}
+				}
+				raise(sig);
+			}
+
+			static auto install_handlers() noexcept -> bool
+			{
+				// backtrace() loads the unwinder on first use, which mustn't happen in a signal handler.
+				void* warm[1];
+				backtrace(warm, 1);
+
+				struct sigaction action{};
+				action.sa_sigaction = crash_signal_handler;
+				action.sa_flags		= SA_SIGINFO | SA_ONSTACK;
+				sigemptyset(&action.sa_mask);
+				for (size_t i = 0; i < std::size(crash_signals); ++i)
+				{
+					if (sigaction(crash_signals[i], &action, &g_previous_actions[i]) != 0)
+					{
+						return false;
+					}
+				}
+				return true;
+			}
+
+			// The handler has to run somewhere when the thread's own stack is what overflowed. Taken off again, and
+			// freed, when the thread exits.
+			struct alternate_stack
+			{
+				static constexpr size_t size = 64 * 1024;
+
+				void* memory = nullptr;
+
+				~alternate_stack()
+				{
+					if (memory != nullptr)
+					{
+						stack_t disable{};
+						disable.ss_flags = SS_DISABLE;
+						sigaltstack(&disable, nullptr);
+						std::free(memory);
+					}
+				}
+			};
+
+			static thread_local alternate_stack t_alternate_stack;
+
+			static auto prepare_thread_stack() noexcept -> bool
+			{
+				if (t_alternate_stack.memory != nullptr)
+				{
+					return true;
+				}
+
+				void* memory = std::malloc(alternate_stack::size);
+				if (memory == nullptr)
+				{
+					return false;
+				}
+				stack_t stack{};
+				stack.ss_sp	  = memory;
+				stack.ss_size = alternate_stack::size;
+				if (sigaltstack(&stack, nullptr) != 0)
+				{
+					std::free(memory);
+					return false;
+				}
+				t_alternate_stack.memory = memory;
+				return true;
+			}
+
+			static auto capture_frames(void** frames, const uint32_t max) noexcept -> uint32_t
+			{
+				const int count = backtrace(frames, static_cast<int>(max));
+				return count > 0 ? static_cast<uint32_t>(count) : 0;
+			}
+
+			static auto write_all(const int fd, const void* data, size_t size) noexcept -> bool
+			{
+				const char* at = static_cast<const char*>(data);
+				while (size > 0)
+				{
+					const ssize_t written = write(fd, at, size);
+					if (written < 0 && errno == EINTR)
+					{
+						continue;
+					}
+					if (written <= 0)
+					{
+						return false;
+					}
+					at += written;
+					size -= static_cast<size_t>(written);
+				}
+				return true;
+			}
+
+			static auto write_dump_file(const char* path, const dump_header& header, const dump_module* modules, const uint32_t count) noexcept -> bool
+			{
+				const int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+				if (fd < 0)
+				{
+					return false;
+				}
+				const bool ok = write_all(fd, &header, sizeof(header)) && write_all(fd, modules, count * sizeof(dump_module));
+				close(fd);
+				return ok;
+			}
+
+			static void read_build_id(const char* notes, const size_t size, dump_module& m) noexcept
+			{
+				const char* at	= notes;
+				const char* end = notes + size;
+				while (at + sizeof(ElfW(Nhdr)) <= end)
+				{
+					ElfW(Nhdr) note;
+					std::memcpy(&note, at, sizeof(note));
+					const char* name = at + sizeof(note);
+					const char* desc = name + ((note.n_namesz + 3) & ~3u);
+					const char* next = desc + ((note.n_descsz + 3) & ~3u);
+					if (next > end)
+					{
+						return;
+					}
+					if (note.n_type == NT_GNU_BUILD_ID && note.n_namesz == 4 && std::memcmp(name, "GNU", 4) == 0)
+					{
+						m.build_id_size = std::min<uint32_t>(note.n_descsz, sizeof(m.build_id));
+						std::memcpy(m.build_id, desc, m.build_id_size);
+						return;
+					}
+					at = next;
+				}
+			}
+
+			static auto add_module(dl_phdr_info* info, size_t, void* data) noexcept -> int
+			{
+				module_table& table = *static_cast<module_table*>(data);
+				if (table.count == max_modules)
+				{
+					return 1;
+				}
+
+				dump_module& m	   = table.modules[table.count];
+				m				   = dump_module{};
+				uint64_t	 start = UINT64_MAX;
+				uint64_t	 end   = 0;
+				for (ElfW(Half) i = 0; i < info->dlpi_phnum; ++i)
+				{
+					const ElfW(Phdr)& segment = info->dlpi_phdr[i];
+					if (segment.p_type == PT_LOAD)
+					{
+						start = std::min<uint64_t>(start, info->dlpi_addr + segment.p_vaddr);
+						end	  = std::max<uint64_t>(end, info->dlpi_addr + segment.p_vaddr + segment.p_memsz);
+					}
+					else if (segment.p_type == PT_NOTE && m.build_id_size == 0)
+					{
+						read_build_id(reinterpret_cast<const char*>(info->dlpi_addr + segment.p_vaddr), segment.p_memsz, m);
+					}
+				}
+				if (end == 0)
+				{
+					return 0;
+				}
+
+				m.start = start;
+				m.end	= end;
+				m.bias	= info->dlpi_addr;
+				if (info->dlpi_name != nullptr && info->dlpi_name[0] != '\0')
+				{
+					copy_path(m.path, sizeof(m.path), info->dlpi_name);
+				}
+				else if (const ssize_t length = readlink("/proc/self/exe", m.path, sizeof(m.path) - 1); length > 0)
+				{
+					// The executable comes first, nameless.
+					m.path[length] = '\0';
+				}
+				++table.count;
+				return 0;
+			}
+
+			static void snapshot_modules(module_table& table) noexcept
+			{
+				table.count = 0;
+				dl_iterate_phdr(add_module, &table);
+			}
+		} // namespace details
+	} // namespace crash
+} // namespace mu
+
+namespace mu
+{
+	namespace time
+	{
+		namespace details
+		{
+			// CLOCK_MONOTONIC_RAW is not slewed by NTP and is served from the vDSO (no syscall) since Linux 5.3.
+			// clock_nanosleep doesn't accept it, so sleeps are expressed against CLOCK_MONOTONIC instead. The TSC is
+			// calibrated against CLOCK_MONOTONIC too, since that is the clock NTP keeps honest over long baselines.
+			static constexpr clockid_t s_os_clock				 = CLOCK_MONOTONIC_RAW;
+			static constexpr clockid_t s_sleep_clock			 = CLOCK_MONOTONIC;
+			static constexpr clockid_t s_reference_clock		 = CLOCK_MONOTONIC;
+			static constexpr int64_t   s_nanoseconds_per_second = 1000000000ll;
+
+			static constexpr int64_t s_max_trusted_skew_ns		 = 1000;		 // Cross-core TSC spread we still call synchronized
+			static constexpr int64_t s_max_window_disagreement	 = 10000;		 // 1 / 100ppm between back-to-back calibration windows
+			static constexpr int64_t s_max_drift_ppb			 = 1000;		 // Republish the frequency once it is off by more than 1ppm
+			static constexpr int64_t s_drift_check_interval_ms	 = 60 * 1000;	 // How often the drift monitor re-measures
+			static constexpr int64_t s_calibration_window_ns	 = 25000000ll; // Each of the two calibration windows
+
+			static inline auto read_clock(const clockid_t clock) noexcept -> int64_t
+			{
+				timespec ts;
+				clock_gettime(clock, &ts);
+				return static_cast<int64_t>(ts.tv_sec) * s_nanoseconds_per_second + ts.tv_nsec;
+			}
+
+			static inline auto to_timespec(const int64_t nanoseconds) noexcept -> timespec
+			{
+				timespec ts;
+				ts.tv_sec  = static_cast<time_t>(nanoseconds / s_nanoseconds_per_second);
+				ts.tv_nsec = static_cast<long>(nanoseconds % s_nanoseconds_per_second);
+				return ts;
+			}
+
+			static void sleep_until(const int64_t deadline_ns) noexcept
+			{
+				const timespec deadline = to_timespec(deadline_ns);
+				while (clock_nanosleep(s_sleep_clock, TIMER_ABSTIME, &deadline, nullptr) == EINTR)
+				{
+				}
+			}
+
+			std::atomic<int64_t>	 s_performance_frequency{s_nanoseconds_per_second};
+			const bool				 s_tick_conversions_ready = publish_tick_conversions(s_nanoseconds_per_second);
+			std::atomic<tick_source> s_tick_source{tick_source::os_monotonic};
+			std::atomic_int			 s_hires_state{0};
+
+			std::atomic_bool	 s_invariant_tsc{false};
+			std::atomic<int64_t> s_tsc_frequency{0};
+			std::atomic<int64_t> s_tsc_skew_ns{0};
+			std::atomic<int64_t> s_drift_ppb{0};
+			std::atomic<int64_t> s_drift_checks{0};
+
+			static void set_performance_frequency(const int64_t frequency) noexcept
+			{
+				s_performance_frequency.store(frequency);
+				publish_tick_conversions(frequency);
+			}
+
+#if MU_TIME_HAS_TSC
+			static inline auto read_tsc() noexcept -> int64_t
+			{
+				return static_cast<int64_t>(__rdtsc());
+			}
+
+			static auto has_invariant_tsc() noexcept -> bool
+			{
+				unsigned int eax, ebx, ecx, edx;
+				if (__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx))
+				{
+					return (edx & (1u << 8)) != 0;
+				}
+				return false;
+			}
+
+			struct clock_sample
+			{
+				int64_t tsc;
+				int64_t ns;
+			};
+
+			// Brackets the reference clock read between two rdtsc's and keeps the tightest of a few tries, which puts
+			// the pairing error in the tens of nanoseconds.
+			static auto sample_clocks() noexcept -> clock_sample
+			{
+				clock_sample best{0, 0};
+				int64_t		 best_width = INT64_MAX;
+				for (int i = 0; i < 8; ++i)
+				{
+					const int64_t before = read_tsc();
+					const int64_t ns	 = read_clock(s_reference_clock);
+					const int64_t after	 = read_tsc();
+					if (after - before < best_width)
+					{
+						best_width = after - before;
+						best	   = {before + (after - before) / 2, ns};
+					}
+				}
+				return best;
+			}
+
+			static auto tsc_frequency_between(const clock_sample& begin, const clock_sample& end) noexcept -> int64_t
+			{
+				if (end.ns <= begin.ns || end.tsc <= begin.tsc)
+				{
+					return 0;
+				}
+				return static_cast<int64_t>(static_cast<__int128>(end.tsc - begin.tsc) * s_nanoseconds_per_second / (end.ns - begin.ns));
+			}
+
+			static auto measure_tsc_frequency(const int64_t window_ns) noexcept -> int64_t
+			{
+				const clock_sample begin = sample_clocks();
+				sleep_until(read_clock(s_sleep_clock) + window_ns);
+				return tsc_frequency_between(begin, sample_clocks());
+			}
+
+			// Pins this thread to each allowed CPU in turn and compares where that core's TSC puts "now" against the
+			// reference clock. Returns the spread between the earliest and latest core in nanoseconds, or -1 if the
+			// thread couldn't be moved.
+			static auto measure_tsc_skew(const int64_t frequency) noexcept -> int64_t
+			{
+				cpu_set_t original;
+				if (sched_getaffinity(0, sizeof(original), &original) != 0)
+				{
+					return -1;
+				}
+
+				bool		 have_reference = false;
+				clock_sample reference{0, 0};
+				int64_t		 min_offset = 0;
+				int64_t		 max_offset = 0;
+
+				for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+				{
+					if (!CPU_ISSET(cpu, &original))
+					{
+						continue;
+					}
+
+					cpu_set_t single;
+					CPU_ZERO(&single);
+					CPU_SET(cpu, &single);
+					if (sched_setaffinity(0, sizeof(single), &single) != 0)
+					{
+						continue;
+					}
+
+					const clock_sample sample = sample_clocks();
+					if (!have_reference)
+					{
+						reference	   = sample;
+						have_reference = true;
+						continue;
+					}
+
+					const int64_t tsc_ns = static_cast<int64_t>(static_cast<__int128>(sample.tsc - reference.tsc) * s_nanoseconds_per_second / frequency);
+					const int64_t offset = tsc_ns - (sample.ns - reference.ns);
+					min_offset			 = std::min(min_offset, offset);
+					max_offset			 = std::max(max_offset, offset);
+				}
+
+				sched_setaffinity(0, sizeof(original), &original);
+				return have_reference ? max_offset - min_offset : -1;
+			}
+
+			// Re-measures the TSC against the sample taken when calibrate() chose it. The baseline only grows, so the
+			// estimate keeps getting more precise; it is republished once the frequency in use is off by more than
+			// s_max_drift_ppb. Each check is two clock reads; skew is left to calibrate(), since measuring it walks
+			// this thread across every CPU.
+			class drift_monitor
+			{
+			public:
+				~drift_monitor()
+				{
+					stop();
+				}
+
+				void start(const clock_sample& anchor) noexcept
+				try
+				{
+					stop();
+					m_anchor = anchor;
+					m_stop	 = false;
+					m_thread = std::thread(
+						[this]()
+						{
+							run();
+						});
+				}
+				catch (...)
+				{
+					// No thread, no drift correction; the calibrated frequency stays in use.
+				}
+
+				void stop() noexcept
+				{
+					{
+						std::lock_guard<std::mutex> lock(m_mutex);
+						m_stop = true;
+					}
+					m_condition.notify_all();
+					if (m_thread.joinable())
+					{
+						m_thread.join();
+					}
+				}
+
+			private:
+				void run() noexcept
+				{
+					std::unique_lock<std::mutex> lock(m_mutex);
+					while (!m_condition.wait_for(
+						lock,
+						std::chrono::milliseconds(s_drift_check_interval_ms),
+						[this]()
+						{
+							return m_stop;
+						}))
+					{
+						check();
+					}
+				}
 
-} // namespace mu
+				void check() noexcept
+				{
+					const int64_t measured = tsc_frequency_between(m_anchor, sample_clocks());
+					if (measured <= 0)
+					{
+						return;
+					}
 
-namespace mu
-{
-	namespace time
-	{
-		namespace details
-		{
-			static auto get_perf_frequency() noexcept -> int64_t
-			{
-				LARGE_INTEGER perf_freq;
-				QueryPerformanceFrequency(&perf_freq);
-				return perf_freq.QuadPart;
-			}
+					const int64_t in_use = s_performance_frequency.load();
+					const int64_t drift	 = static_cast<int64_t>(static_cast<__int128>(in_use - measured) * s_nanoseconds_per_second / measured);
 
-			int64_t			s_performance_frequency = get_perf_frequency();
-			std::atomic_int s_hires_state{0};
+					s_tsc_frequency.store(measured);
+					s_drift_ppb.store(drift);
+					s_drift_checks.fetch_add(1);
+
+					if ((drift > s_max_drift_ppb || drift < -s_max_drift_ppb) && s_tick_source.load() == tick_source::tsc)
+					{
+						set_performance_frequency(measured);
+					}
+				}
+
+				std::mutex				m_mutex;
+				std::condition_variable m_condition;
+				std::thread				m_thread;
+				clock_sample			m_anchor{0, 0};
+				bool					m_stop = false;
+			};
+
+			drift_monitor s_drift_monitor;
+#endif // #if MU_TIME_HAS_TSC
 
 		} // namespace details
 
 		auto performance_frequency() noexcept -> int64_t
 		{
-			return details::s_performance_frequency;
+			return details::s_performance_frequency.load(std::memory_order_relaxed);
 		}
 
 		void calibrate() noexcept
 		{
-			// TBD
+#if MU_TIME_HAS_TSC
+			details::s_drift_monitor.stop();
+
+			const bool invariant = details::has_invariant_tsc();
+			details::s_invariant_tsc.store(invariant);
+
+			if (invariant)
+			{
+				// Two back-to-back windows have to agree before the TSC is trusted; the frequency used spans both.
+				const details::clock_sample first = details::sample_clocks();
+				details::sleep_until(details::read_clock(details::s_sleep_clock) + details::s_calibration_window_ns);
+				const details::clock_sample second = details::sample_clocks();
+				details::sleep_until(details::read_clock(details::s_sleep_clock) + details::s_calibration_window_ns);
+				const details::clock_sample third = details::sample_clocks();
+
+				const int64_t first_window	= details::tsc_frequency_between(first, second);
+				const int64_t second_window = details::tsc_frequency_between(second, third);
+				const int64_t frequency		= details::tsc_frequency_between(first, third);
+				const int64_t skew			= frequency > 0 ? details::measure_tsc_skew(frequency) : -1;
+
+				details::s_tsc_frequency.store(frequency);
+				details::s_tsc_skew_ns.store(skew);
+				details::s_drift_ppb.store(0);
+
+				const int64_t disagreement = first_window > second_window ? first_window - second_window : second_window - first_window;
+				const bool	  stable	   = first_window > 0 && second_window > 0 && disagreement <= frequency / details::s_max_window_disagreement;
+
+				if (stable && skew >= 0 && skew <= details::s_max_trusted_skew_ns)
+				{
+					details::set_performance_frequency(frequency);
+					details::s_tick_source.store(tick_source::tsc);
+					details::s_drift_monitor.start(first);
+					return;
+				}
+			}
+#endif
+			details::set_performance_frequency(details::s_nanoseconds_per_second);
+			details::s_tick_source.store(tick_source::os_monotonic);
 		}
 
 		void init() noexcept
 		{
-			details::s_performance_frequency = details::get_perf_frequency();
+			details::set_performance_frequency(details::s_performance_frequency.load());
 		}
 
 		auto get_now() noexcept -> int64_t
 		{
-			LARGE_INTEGER now;
-			QueryPerformanceCounter(&now);
-			return now.QuadPart;
+#if MU_TIME_HAS_TSC
+			if (details::s_tick_source.load(std::memory_order_relaxed) == tick_source::tsc)
+			{
+				return details::read_tsc();
+			}
+#endif
+			return details::read_clock(details::s_os_clock);
 		}
 
 		void sleep(const int64_t milliseconds) noexcept
 		{
-			::Sleep(static_cast<DWORD>(milliseconds));
+			details::sleep_until(details::read_clock(details::s_sleep_clock) + milliseconds * 1000000ll);
 		}
 
 		void micro_sleep(const int64_t ticks) noexcept
 		{
-			LARGE_INTEGER current_moment;
-			LARGE_INTEGER end_moment;
+			micro_sleep_until(get_now() + ticks);
+		}
 
-			QueryPerformanceCounter(&end_moment);
-			end_moment.QuadPart += ticks;
+		void micro_sleep_until(const int64_t deadline) noexcept
+		{
+			// Without this the kernel may coalesce the wakeup up to 50us late, which would all have to be spun away.
+			static thread_local const bool precise_wakeups = prctl(PR_SET_TIMERSLACK, 1ul, 0ul, 0ul, 0ul) == 0;
+			(void)precise_wakeups;
 
-			do
-			{
-				SwitchToThread();
-				QueryPerformanceCounter(&current_moment);
-			}
-			while (current_moment.QuadPart < end_moment.QuadPart);
+			details::s_sleeper.sleep_until(
+				deadline,
+				[](const int64_t wake_target)
+				{
+					const int64_t remaining_ns = details::conversions().to_nanoseconds.convert<int64_t>(wake_target - get_now());
+					details::sleep_until(details::read_clock(details::s_sleep_clock) + remaining_ns);
+				});
 		}
 
 		void set_high_resolution_timer() noexcept
 		{
-			const int prev_state = details::s_hires_state.fetch_add(1);
-			if (prev_state == 0)
-			{
-				timeBeginPeriod(1);
-			}
+			// hrtimers are always on; only the reference count is kept so the calls stay balanced across platforms.
+			details::s_hires_state.fetch_add(1);
 		}
 
 		auto release_high_resolution_timer() noexcept -> leaf::result<void>
 		try
 		{
 			const int prev_state = details::s_hires_state.fetch_sub(1);
-			if (prev_state == 1)
-			{
-				timeEndPeriod(1);
-			}
-			else if (prev_state <= 0)
+			if (prev_state <= 0)
 			{
 				//"Unbalanced HighResolutionTimer reference count"
 				return MU_LEAF_NEW_ERROR(runtime_error::not_specified{});
@@ -263,202 +4474,56 @@ namespace mu
 		{
 			return MU_LEAF_NEW_ERROR(runtime_error::not_specified{});
 		}
-	} // namespace time
-
-} // namespace mu
-
-// Implement some of the functions and types normally declared in recent Windows SDK.
-#if !defined(_versionhelpers_H_INCLUDED_) && !defined(_INC_VERSIONHELPERS)
-static BOOL IsWindowsVersionOrGreater(WORD major, WORD minor, WORD sp)
-{
-	OSVERSIONINFOEXW osvi = {sizeof(osvi), major, minor, 0, 0, {0}, sp, 0, 0, 0, 0};
-	DWORD			 mask = VER_MAJORVERSION | VER_MINORVERSION | VER_SERVICEPACKMAJOR;
-	ULONGLONG		 cond = ::VerSetConditionMask(0, VER_MAJORVERSION, VER_GREATER_EQUAL);
-	cond				  = ::VerSetConditionMask(cond, VER_MINORVERSION, VER_GREATER_EQUAL);
-	cond				  = ::VerSetConditionMask(cond, VER_SERVICEPACKMAJOR, VER_GREATER_EQUAL);
-	return ::VerifyVersionInfoW(&osvi, mask, cond);
-}
-#define IsWindows8Point1OrGreater() IsWindowsVersionOrGreater(HIBYTE(0x0602), LOBYTE(0x0602), 0) // _WIN32_WINNT_WINBLUE
-#endif
-
-#ifndef DPI_ENUMS_DECLARED
-typedef enum
-{
-	PROCESS_DPI_UNAWARE			  = 0,
-	PROCESS_SYSTEM_DPI_AWARE	  = 1,
-	PROCESS_PER_MONITOR_DPI_AWARE = 2
-} PROCESS_DPI_AWARENESS;
-typedef enum
-{
-	MDT_EFFECTIVE_DPI = 0,
-	MDT_ANGULAR_DPI	  = 1,
-	MDT_RAW_DPI		  = 2,
-	MDT_DEFAULT		  = MDT_EFFECTIVE_DPI
-} MONITOR_DPI_TYPE;
-#endif
-#ifndef _DPI_AWARENESS_CONTEXTS_
-DECLARE_HANDLE(DPI_AWARENESS_CONTEXT);
-#define DPI_AWARENESS_CONTEXT_PER_MONITOR_AWARE (DPI_AWARENESS_CONTEXT) - 3
-#endif
-#ifndef DPI_AWARENESS_CONTEXT_PER_MONITOR_AWARE_V2
-#define DPI_AWARENESS_CONTEXT_PER_MONITOR_AWARE_V2 (DPI_AWARENESS_CONTEXT) - 4
-#endif
-typedef HRESULT(WINAPI* PFN_SetProcessDpiAwareness)(PROCESS_DPI_AWARENESS);						// Shcore.lib + dll, Windows 8.1+
-typedef HRESULT(WINAPI* PFN_GetDpiForMonitor)(HMONITOR, MONITOR_DPI_TYPE, UINT*, UINT*);		// Shcore.lib + dll, Windows 8.1+
-typedef DPI_AWARENESS_CONTEXT(WINAPI* PFN_SetThreadDpiAwarenessContext)(DPI_AWARENESS_CONTEXT); // User32.lib + dll, Windows 10 v1607+ (Creators Update)
-
-#if defined(_MSC_VER) && !defined(NOGDI)
-#pragma comment(lib, "gdi32") // Link with gdi32.lib for GetDeviceCaps()
-#endif
 
-namespace mu
-{
-	// Helper function to enable DPI awareness without setting up a manifest
-	void enable_dpi_awareness() noexcept
-	try
-	{
-		// if (IsWindows10OrGreater()) // This needs a manifest to succeed. Instead we try to grab the function pointer!
+		auto get_tick_source() noexcept -> tick_source
 		{
-			static HINSTANCE user32_dll = ::LoadLibraryA("user32.dll"); // Reference counted per-process
-			if (PFN_SetThreadDpiAwarenessContext SetThreadDpiAwarenessContextFn = (PFN_SetThreadDpiAwarenessContext)::GetProcAddress(user32_dll, "SetThreadDpiAwarenessContext"))
-			{
-				SetThreadDpiAwarenessContextFn(DPI_AWARENESS_CONTEXT_PER_MONITOR_AWARE_V2);
-				return;
-			}
+			return details::s_tick_source.load(std::memory_order_relaxed);
 		}
 
-		if (IsWindows8Point1OrGreater())
+		auto set_tick_source(tick_source source) noexcept -> bool
 		{
-			static HINSTANCE shcore_dll = ::LoadLibraryA("shcore.dll"); // Reference counted per-process
-			if (PFN_SetProcessDpiAwareness SetProcessDpiAwarenessFn = (PFN_SetProcessDpiAwareness)::GetProcAddress(shcore_dll, "SetProcessDpiAwareness"))
+			switch (source)
 			{
-				SetProcessDpiAwarenessFn(PROCESS_PER_MONITOR_DPI_AWARE);
-				return;
-			}
-		}
-#if _WIN32_WINNT >= 0x0600
-		::SetProcessDPIAware();
+			case tick_source::os_monotonic:
+#if MU_TIME_HAS_TSC
+				details::s_drift_monitor.stop();
 #endif
-	}
-	catch (...)
-	{
-		// TODO: log error
-	}
-
-	auto get_dpi_scale_for_monitor(void* monitor) noexcept -> float
-	try
-	{
-		UINT		xdpi = 96, ydpi = 96;
-		static BOOL bIsWindows8Point1OrGreater = IsWindows8Point1OrGreater();
-		if (bIsWindows8Point1OrGreater)
-		{
-			static HINSTANCE shcore_dll = ::LoadLibraryA("shcore.dll"); // Reference counted per-process
-			if (PFN_GetDpiForMonitor GetDpiForMonitorFn = (PFN_GetDpiForMonitor)::GetProcAddress(shcore_dll, "GetDpiForMonitor"))
-				GetDpiForMonitorFn((HMONITOR)monitor, MDT_EFFECTIVE_DPI, &xdpi, &ydpi);
-		}
-#ifndef NOGDI
-		else
-		{
-			const HDC dc = ::GetDC(NULL);
-			xdpi		 = ::GetDeviceCaps(dc, LOGPIXELSX);
-			ydpi		 = ::GetDeviceCaps(dc, LOGPIXELSY);
-			::ReleaseDC(NULL, dc);
-		}
+				details::set_performance_frequency(details::s_nanoseconds_per_second);
+				details::s_tick_source.store(source);
+				return true;
+#if MU_TIME_HAS_TSC
+			case tick_source::tsc:
+				// Measured once here; a monitor left running from calibrate() would publish against it.
+				details::s_drift_monitor.stop();
+				details::s_invariant_tsc.store(details::has_invariant_tsc());
+				if (details::s_invariant_tsc.load())
+				{
+					if (const int64_t frequency = details::measure_tsc_frequency(20000000ll); frequency > 0)
+					{
+						details::s_tsc_frequency.store(frequency);
+						details::set_performance_frequency(frequency);
+						details::s_tick_source.store(source);
+						return true;
+					}
+				}
+				return false;
 #endif
-		assert(xdpi == ydpi); // Please contact me if you hit this assert!
-		return xdpi / 96.0f;
-	}
-	catch (...)
-	{
-		return 1.0f;
-	}
-
-	auto get_dpi_scale_for_hwnd(void* hwnd) noexcept -> float
-	try
-	{
-		HMONITOR monitor = ::MonitorFromWindow((HWND)hwnd, MONITOR_DEFAULTTONEAREST);
-		return get_dpi_scale_for_monitor(monitor);
-	}
-	catch (...)
-	{
-		return 1.0f;
-	}
-} // namespace mu
-
-#endif // #ifdef _WINDOWS_
-
-#ifdef __APPLE__
-#include <mach/mach_time.h>
-
-namespace mu
-{
-	namespace time
-	{
-		namespace details
-		{
-			static auto get_perf_frequency() noexcept -> int64_t
-			{
-				mach_timebase_info_data_t mach_info;
-				mach_timebase_info(&mach_info);
-				return (mach_info.denom * 1000000000) / mach_info.numer;
-			}
-
-			int64_t			s_performance_frequency = get_perf_frequency();
-			uint64_t		s_initial{0};
-			std::atomic_int s_hires_state{0};
-
-		} // namespace details
-
-		auto performance_frequency() noexcept -> int64_t
-		{
-			return details::s_performance_frequency;
-		}
-
-		void calibrate() noexcept
-		{
-			// TBD
-		}
-
-		void init() noexcept
-		{
-			details::s_initial = mach_absolute_time();
-		}
-
-		auto get_now() noexcept -> int64_t
-		{
-			return mach_absolute_time() - details::s_initial;
-		}
-
-		void sleep(const int64_t milliseconds) noexcept
-		{
-			micro_sleep(((milliseconds * static_cast<long double>(performance_frequency()) * static_cast<long double>(1000ull))));
-		}
-
-		void micro_sleep(const int64_t ticks) noexcept
-		{
-			mach_wait_until(mach_absolute_time() + ticks);
-		}
-
-		void set_high_resolution_timer() noexcept
-		{
-			const int prev_state = details::s_hires_state.fetch_add(1);
-			if (prev_state == 0)
-			{
-				// timeBeginPeriod(1);
+			default:
+				return false;
 			}
 		}
 
-		void release_high_resolution_timer()
+		auto get_calibration_info() noexcept -> calibration_info
 		{
-			const int prev_state = details::s_hires_state.fetch_sub(1);
-			if (prev_state == 1)
-			{
-				// timeEndPeriod(1);
-			}
-			else if (prev_state <= 0)
-			{
-				throw std::runtime_error("Unbalanced HighResolutionTimer reference count");
-			}
+			calibration_info info;
+			info.source		   = details::s_tick_source.load();
+			info.frequency	   = details::s_performance_frequency.load();
+			info.tsc_frequency = details::s_tsc_frequency.load();
+			info.invariant_tsc = details::s_invariant_tsc.load();
+			info.tsc_skew_ns   = details::s_tsc_skew_ns.load();
+			info.drift_ppb	   = details::s_drift_ppb.load();
+			info.drift_checks  = details::s_drift_checks.load();
+			return info;
 		}
 	} // namespace time
 
@@ -468,18 +4533,18 @@ namespace mu
 {
 	void enable_dpi_awareness() noexcept { }
 
-	auto get_dpi_scale_for_monitor(void* monitor) noexcept -> float
+	auto get_dpi_scale_for_monitor([[maybe_unused]] void* monitor) noexcept -> float
 	{
 		return 1.0f;
 	}
 
-	auto get_dpi_scale_for_hwnd(void* hwnd) noexcept -> float
+	auto get_dpi_scale_for_hwnd([[maybe_unused]] void* hwnd) noexcept -> float
 	{
 		return 1.0f;
 	}
 } // namespace mu
 
-#endif // #ifdef __APPLE__
+#endif // #ifdef __linux__
 
 #include <nfd.h>
 #include <boxer/boxer.h>
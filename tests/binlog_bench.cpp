@@ -0,0 +1,102 @@
+#include <mu_stdlib_binlog.h>
+
+#include <spdlog/sinks/null_sink.h>
+#include <spdlog/sinks/ostream_sink.h>
+
+#include <chrono>
+#include <cstdio>
+#include <sstream>
+#include <string>
+#include <thread>
+
+namespace details
+{
+	static constexpr int iterations = 200000;
+	static constexpr int burst		= 10000; // ~480KB of records, well inside one thread's ring
+
+	// Times bursts, and lets the writer catch up between them so the binary path isn't measuring its drops.
+	template<typename T_FUNC>
+	auto ns_per_call(T_FUNC func) -> double
+	{
+		double total = 0;
+		for (int i = 0; i < iterations;)
+		{
+			const auto begin = std::chrono::steady_clock::now();
+			for (const int end = i + burst; i < end; ++i)
+			{
+				func(i);
+			}
+			total += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - begin).count();
+			std::this_thread::sleep_for(std::chrono::milliseconds(20));
+		}
+		return total / iterations;
+	}
+} // namespace details
+
+int main(int, char**)
+{
+	const std::string path = "binlog_bench.mubin";
+
+	mu::debug::logger_options options;
+	options.binary		= true;
+	options.binary_path = path;
+	if (!mu::debug::configure_logger(options))
+	{
+		return 1;
+	}
+
+	// Formatting into a sink that discards it: the cost the binary path takes off the calling thread.
+	spdlog::logger formatted("formatted", std::make_shared<spdlog::sinks::null_sink_mt>());
+
+	// Warm up both paths (ring allocation, site registration).
+	MU_BINLOG(info, "frame {0} took {1:.3f} ms on {2}", 0, 0.0, "warmup");
+	formatted.info("frame {0} took {1:.3f} ms on {2}", 0, 0.0, "warmup");
+
+	const double spdlog_ns = details::ns_per_call(
+		[&formatted](const int i)
+		{
+			formatted.info("frame {0} took {1:.3f} ms on {2}", i, i * 0.001, "render");
+		});
+	const double binlog_ns = details::ns_per_call(
+		[](const int i)
+		{
+			MU_BINLOG(info, "frame {0} took {1:.3f} ms on {2}", i, i * 0.001, "render");
+			(void)i;
+		});
+
+	const uint64_t dropped = mu::binlog::dropped();
+	printf("spdlog (format, null sink): %.1f ns/call\nMU_BINLOG:                  %.1f ns/call, %llu dropped\n", spdlog_ns, binlog_ns, static_cast<unsigned long long>(dropped));
+
+	// Write everything out and read it back.
+	std::ostringstream decoded;
+	{
+		auto sink = std::make_shared<spdlog::sinks::ostream_sink_mt>(decoded);
+		sink->set_pattern("%v");
+		spdlog::logger reader("reader", sink);
+
+		// The writer drains every few milliseconds; wait for the file to hold the last record.
+		bool found = false;
+		for (int attempt = 0; attempt < 200 && !found; ++attempt)
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(10));
+			decoded.str("");
+			found = mu::binlog::decode_file(path.c_str(), reader) && decoded.str().find("frame 199999 took 199.999 ms on render") != std::string::npos;
+		}
+		if (!found)
+		{
+			printf("capture is missing records\n");
+			return 1;
+		}
+	}
+
+	const std::string text = decoded.str();
+	size_t			  lines = 0;
+	for (const char c : text)
+	{
+		lines += c == '\n';
+	}
+	printf("decoded %zu records, first: %s", lines, text.substr(0, text.find('\n') + 1).c_str());
+	std::remove(path.c_str());
+
+	return dropped == 0 && lines == static_cast<size_t>(details::iterations) + 1 && text.rfind("frame 0 took 0.000 ms on warmup\n", 0) == 0 ? 0 : 1;
+}
@@ -0,0 +1,105 @@
+#include <mu_stdlib_crash.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+namespace details
+{
+	auto recurse(const int depth) -> int
+	{
+		volatile char frame[1024];
+		frame[0] = static_cast<char>(depth);
+		return depth < 0 ? 0 : recurse(depth + 1) + frame[0];
+	}
+
+	auto child(const std::string& mode, const char* path) -> int
+	{
+		if (!mu::crash::install(path))
+		{
+			return 1;
+		}
+
+		if (mode == "fault")
+		{
+			volatile uintptr_t address = 8;
+			*reinterpret_cast<volatile int*>(address) = 1;
+		}
+		else if (mode == "overflow")
+		{
+			// Not the thread that installed the handlers.
+			std::thread(
+				[]()
+				{
+					mu::crash::prepare_thread();
+					std::printf("%d\n", recurse(0));
+				})
+				.join();
+		}
+		else
+		{
+			std::thread(
+				[]()
+				{
+					throw std::runtime_error("unhandled");
+				})
+				.join();
+		}
+		return 1;
+	}
+
+	// Crashes a child the given way and checks the dump it left.
+	auto check(const char* argv0, const char* mode) -> bool
+	{
+		const std::string path = (std::filesystem::temp_directory_path() / (std::string("mu_crash_dump_test_") + mode + ".mudump")).string();
+		std::filesystem::remove(path);
+		std::system(("\"" + std::string(argv0) + "\" " + mode + " \"" + path + "\"").c_str());
+
+		mu::crash::dump dump;
+		if (!mu::crash::read_dump(path.c_str(), dump))
+		{
+			printf("%s: no dump\n", mode);
+			return false;
+		}
+		std::filesystem::remove(path);
+
+		// Some frame has to be in this executable, whatever the handler frames above it.
+		const std::string self	   = std::filesystem::path(argv0).filename().string();
+		bool			  in_self  = false;
+		bool			  build_id = false;
+		for (uint32_t i = 0; i < dump.header.frame_count; ++i)
+		{
+			const mu::crash::dump_module* module = dump.find_module(dump.header.frames[i]);
+			if (module != nullptr && std::string(module->path).find(self) != std::string::npos)
+			{
+				in_self	 = true;
+				build_id = module->build_id_size != 0;
+			}
+		}
+
+		const std::string m	   = mode;
+		const bool		  kind = m == "fault"	  ? dump.header.kind != mu::crash::dump_kind::terminate && dump.header.fault_address == 8
+								 : m == "overflow" ? dump.header.kind != mu::crash::dump_kind::terminate
+												   : dump.header.kind == mu::crash::dump_kind::terminate;
+		printf("%s: kind %u code %u fault 0x%llx, %u frames, %u modules, %s, build id %s\n", mode, static_cast<unsigned>(dump.header.kind), dump.header.code,
+			   static_cast<unsigned long long>(dump.header.fault_address), dump.header.frame_count, dump.header.module_count, in_self ? "frames in this executable" : "no frame here",
+			   build_id ? "present" : "absent");
+		return kind && in_self && dump.header.module_count > 0;
+	}
+} // namespace details
+
+int main(int argc, char** argv)
+{
+	if (argc == 3)
+	{
+		return details::child(argv[1], argv[2]);
+	}
+
+	const bool fault	 = details::check(argv[0], "fault");
+	const bool overflow	 = details::check(argv[0], "overflow");
+	const bool terminate = details::check(argv[0], "terminate");
+	return fault && overflow && terminate ? 0 : 1;
+}
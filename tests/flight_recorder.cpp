@@ -0,0 +1,107 @@
+#include <mu_stdlib_flight.h>
+
+#include <spdlog/sinks/ostream_sink.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <sstream>
+#include <string>
+#include <thread>
+
+namespace details
+{
+	constexpr uint32_t ring_events = 1024;
+	constexpr int64_t  recorded	   = 5000; // Per thread, enough to wrap
+	constexpr int	   churn	   = 16;   // Short-lived threads before the worker, each taking over the last one's ring
+
+	// Records on two threads, then aborts: no destructors, no flushing, nothing but what is already in the page cache.
+	auto child(const char* directory) -> int
+	{
+		if (!mu::flight::start(directory, ring_events))
+		{
+			return 1;
+		}
+		mu::flight::set_thread_name("main");
+
+		for (int i = 0; i < churn; ++i)
+		{
+			std::thread t(
+				[i]()
+				{
+					mu::flight::set_thread_name("churn");
+					MU_FLIGHT("churn step", i);
+				});
+			t.join();
+		}
+
+		std::thread worker(
+			[]()
+			{
+				mu::flight::set_thread_name("worker");
+				for (int64_t i = 0; i < recorded; ++i)
+				{
+					MU_FLIGHT("worker step", i, i * 2);
+				}
+			});
+		worker.join();
+
+		const auto begin = std::chrono::steady_clock::now();
+		for (int64_t i = 0; i < recorded; ++i)
+		{
+			MU_FLIGHT("main step", i);
+		}
+		const double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - begin).count() / recorded;
+		printf("%.1f ns per event\n", ns);
+		fflush(stdout);
+
+		std::abort();
+	}
+} // namespace details
+
+int main(int argc, char** argv)
+{
+	if (argc == 3 && std::string(argv[1]) == "child")
+	{
+		return details::child(argv[2]);
+	}
+
+	const std::string directory = (std::filesystem::temp_directory_path() / "mu_flight_recorder_test").string();
+	std::filesystem::remove_all(directory);
+	std::system(("\"" + std::string(argv[0]) + "\" child \"" + directory + "\"").c_str());
+
+	std::ostringstream out;
+	spdlog::logger	   l("decode", std::make_shared<spdlog::sinks::ostream_sink_mt>(out));
+	l.set_pattern("%v");
+	if (!mu::flight::decode(directory.c_str(), mu::time::seconds(60), l))
+	{
+		printf("decode failed\n");
+		return 1;
+	}
+
+	// Each ring keeps its newest ring_events - 1 events; the slot being overwritten is skipped.
+	const std::string text = out.str();
+	size_t			  lines = 0;
+	for (const char c : text)
+	{
+		lines += c == '\n';
+	}
+	const bool worker_last = text.find("[worker] worker step 4999 9998\n") != std::string::npos;
+	const bool main_last   = text.find("[main] main step 4999 0\n") != std::string::npos;
+	const bool oldest	   = text.find("[main] main step 3977 0\n") != std::string::npos && text.find("[main] main step 3976 0\n") == std::string::npos;
+	const bool churned	   = text.find("churn") == std::string::npos;
+	printf("%zu events decoded, last of each thread %s, oldest kept %s, churn %s\n", lines, worker_last && main_last ? "found" : "missing", oldest ? "as expected" : "wrong",
+		   churned ? "overwritten" : "left behind");
+
+	// The churning threads and the worker all shared one ring after main's.
+	size_t rings = 0;
+	for (const auto& entry : std::filesystem::directory_iterator(directory))
+	{
+		rings += entry.path().filename().string().starts_with("thread-");
+	}
+	printf("%zu ring files for %d threads\n", rings, details::churn + 2);
+
+	std::filesystem::remove_all(directory);
+	return lines == 2 * (details::ring_events - 1) && worker_last && main_last && oldest && churned && rings == 2 ? 0 : 1;
+}
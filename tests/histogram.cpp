@@ -0,0 +1,130 @@
+#include <mu_stdlib_histogram.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace details
+{
+	static constexpr uint32_t thread_count		= 4;
+	static constexpr uint32_t records_per_thread = 1000000;
+
+	// Relative error of a percentile against the exact value from the sorted samples.
+	auto relative_error(const std::vector<int64_t>& sorted, const mu::time::histogram_snapshot<>& snapshot, const double p) -> double
+	{
+		const size_t  rank	 = std::min(sorted.size() - 1, static_cast<size_t>(static_cast<double>(sorted.size()) * p / 100.0 + 0.5) - 1);
+		const int64_t exact	 = sorted[rank];
+		const int64_t approx = snapshot.percentile(p).as_ticks<int64_t>();
+		return exact != 0 ? static_cast<double>(approx - exact) / static_cast<double>(exact) : 0.0;
+	}
+} // namespace details
+
+int main(int, char**)
+{
+	mu::time::init();
+
+	int failures = 0;
+
+	// Accuracy: a log-normal spread of latencies against exact percentiles.
+	{
+		mu::time::histogram<> h;
+
+		std::mt19937_64				rng(11);
+		std::lognormal_distribution<> dist(10.0, 1.5);
+		std::vector<int64_t>		samples(200000);
+		for (auto& s : samples)
+		{
+			s = static_cast<int64_t>(dist(rng));
+			h.record_ticks(s);
+		}
+		std::sort(samples.begin(), samples.end());
+
+		const auto snapshot = h.snapshot();
+		for (const double p : {50.0, 90.0, 99.0, 99.9})
+		{
+			const double error = details::relative_error(samples, snapshot, p);
+			printf("p%-5g %10lld ticks, error %+.3f%%\n", p, static_cast<long long>(snapshot.percentile(p).as_ticks<int64_t>()), error * 100.0);
+			if (error < 0.0 || error > 1.0 / 32.0)
+			{
+				++failures;
+			}
+		}
+
+		if (snapshot.count() != samples.size() || snapshot.max().as_ticks<int64_t>() < samples.back() || snapshot.min().as_ticks<int64_t>() > samples.front())
+		{
+			++failures;
+		}
+	}
+
+	// Concurrent recording, merge, and reset-on-read.
+	{
+		mu::time::histogram<> h;
+
+		const auto				 begin = std::chrono::steady_clock::now();
+		std::vector<std::thread> threads;
+		for (uint32_t t = 0; t < details::thread_count; ++t)
+		{
+			threads.emplace_back(
+				[&h, t]()
+				{
+					for (uint32_t i = 0; i < details::records_per_thread; ++i)
+					{
+						h.record_ticks(static_cast<int64_t>((i & 1023) + t));
+					}
+				});
+		}
+		for (auto& thread : threads)
+		{
+			thread.join();
+		}
+		const auto end = std::chrono::steady_clock::now();
+
+		const uint64_t expected = static_cast<uint64_t>(details::thread_count) * details::records_per_thread;
+		const auto	   first	= h.snapshot(true);
+		h.record(mu::time::microseconds(5));
+		const auto second = h.snapshot(true);
+		const auto third  = h.snapshot();
+
+		auto merged = first;
+		merged.merge(second);
+
+		printf(
+			"record: %.2f ns/op across %u threads, count %llu, after reset %llu, merged %llu\n",
+			std::chrono::duration<double, std::nano>(end - begin).count() / static_cast<double>(expected),
+			details::thread_count,
+			static_cast<unsigned long long>(first.count()),
+			static_cast<unsigned long long>(second.count()),
+			static_cast<unsigned long long>(merged.count()));
+
+		if (first.count() != expected || second.count() != 1 || third.count() != 0 || merged.count() != expected + 1)
+		{
+			++failures;
+		}
+	}
+
+	// Scope timing.
+	{
+		mu::time::histogram<> h;
+		for (int i = 0; i < 100; ++i)
+		{
+			mu::time::histogram<>::scope timed(h);
+			mu::time::micro_sleep_microseconds(100);
+		}
+		const auto snapshot = h.snapshot();
+		printf(
+			"micro_sleep(100us): p50 %.1f us, p99 %.1f us, max %.1f us\n",
+			snapshot.percentile(50).as_microseconds<double>(),
+			snapshot.percentile(99).as_microseconds<double>(),
+			snapshot.max().as_microseconds<double>());
+
+		if (snapshot.count() != 100 || snapshot.percentile(50) < mu::time::microseconds(100))
+		{
+			++failures;
+		}
+	}
+
+	return failures == 0 ? 0 : 1;
+}
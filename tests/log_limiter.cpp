@@ -0,0 +1,124 @@
+#include <mu_stdlib.h>
+
+#include <spdlog/sinks/null_sink.h>
+#include <spdlog/sinks/ostream_sink.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+int main(int, char**)
+{
+	// Reports only when asked, so the one below sees every count.
+	mu::debug::logger_options options;
+	options.suppressed_report_period = mu::time::seconds(0);
+	if (!mu::debug::configure_logger(options))
+	{
+		return 1;
+	}
+
+	bool ok = true;
+
+	// Bucket: a burst of 5, then nothing for the rest of the second.
+	{
+		static mu::debug::log_limiter limiter(__FILE__, __LINE__, 1, 5);
+		int							  allowed = 0;
+		for (int i = 0; i < 100; ++i)
+		{
+			allowed += limiter.allow() ? 1 : 0;
+		}
+		const uint64_t suppressed = limiter.take_suppressed();
+		std::printf("burst: %d allowed, %llu suppressed\n", allowed, static_cast<unsigned long long>(suppressed));
+		ok = ok && allowed == 5 && suppressed == 95 && limiter.take_suppressed() == 0;
+	}
+
+	// Sampling alone: every 4th.
+	{
+		static mu::debug::log_limiter limiter(__FILE__, __LINE__, 0, 0, 4);
+		int							  allowed = 0;
+		for (int i = 0; i < 100; ++i)
+		{
+			allowed += limiter.allow() ? 1 : 0;
+		}
+		std::printf("sampled: %d allowed\n", allowed);
+		ok = ok && allowed == 25;
+	}
+
+	// One site hammered from several threads; arguments are only evaluated for messages that get through.
+	{
+		static constexpr int threads	= 4;
+		static constexpr int per_thread = 100000;
+
+		spdlog::logger			 sink("null", std::make_shared<spdlog::sinks::null_sink_mt>());
+		std::atomic<int>		 allowed{0};
+		const auto				 begin = std::chrono::steady_clock::now();
+		std::vector<std::thread> workers;
+		for (int t = 0; t < threads; ++t)
+		{
+			workers.emplace_back(
+				[&]()
+				{
+					for (int i = 0; i < per_thread; ++i)
+					{
+						MU_LOG_LIMITED(sink, info, 100, 10, "message {0}", allowed.fetch_add(1, std::memory_order_relaxed));
+					}
+				});
+		}
+		for (auto& w : workers)
+		{
+			w.join();
+		}
+		const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+		const int	 bound	 = 10 + static_cast<int>(100 * seconds) + 1;
+		std::printf("threads: %d of %d allowed in %.3f s (at most %d)\n", allowed.load(), threads * per_thread, seconds, bound);
+		ok = ok && allowed.load() >= 10 && allowed.load() <= bound;
+	}
+
+	// A flood through the error handlers logs the default burst from the failing site, and the rest shows up in the
+	// report under that site. Another site's errors still get through.
+	{
+		uint32_t flood_line = 0;
+		for (int i = 0; i < 1000; ++i)
+		{
+			mu::try_handle(
+				[&]() -> mu::leaf::result<void>
+				{
+					flood_line = __LINE__ + 1;
+					return MU_LEAF_NEW_ERROR(mu::common_error{});
+				});
+		}
+
+		uint32_t quiet_line = 0;
+		for (int i = 0; i < 5; ++i)
+		{
+			mu::try_handle(
+				[&]() -> mu::leaf::result<void>
+				{
+					quiet_line = __LINE__ + 1;
+					return MU_LEAF_NEW_ERROR(mu::runtime_error::not_specified{});
+				});
+		}
+
+		std::ostringstream stream;
+		spdlog::logger	   report("report", std::make_shared<spdlog::sinks::ostream_sink_st>(stream));
+		report.set_pattern("%v");
+		mu::debug::report_suppressed_logs(report);
+		std::printf("report:\n%s", stream.str().c_str());
+
+		// Allow for a little refill while the burst was written out.
+		const std::string text		 = stream.str();
+		const size_t	  site		 = text.find(std::string(__FILE__) + ":" + std::to_string(flood_line) + " ");
+		unsigned long	  suppressed = 0;
+		if (site == std::string::npos || std::sscanf(text.c_str() + site, "%*[^ ] suppressed %lu", &suppressed) != 1)
+		{
+			return 1;
+		}
+		ok = ok && suppressed >= 900 && suppressed <= 1000 - mu::debug::log_limiter::default_burst;
+		ok = ok && text.find(std::string(__FILE__) + ":" + std::to_string(quiet_line) + " ") == std::string::npos;
+	}
+
+	return ok ? 0 : 1;
+}
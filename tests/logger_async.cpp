@@ -0,0 +1,57 @@
+#include <mu_stdlib.h>
+
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+int main(int, char**)
+{
+	static constexpr int threads	 = 4;
+	static constexpr int per_thread = 20000;
+
+	mu::debug::logger_options options;
+	options.async		   = true;
+	options.overflow	   = mu::debug::log_overflow_policy::block;
+	options.queue_capacity = 256;
+	if (!mu::debug::configure_logger(options))
+	{
+		return 1;
+	}
+
+	// Keep the volume off the terminal; the sink holds on to the same FILE*.
+	if (std::freopen("/dev/null", "w", stdout) == nullptr)
+	{
+		return 1;
+	}
+
+	auto out = mu::debug::logger()->stdout_logger();
+
+	const auto				 begin = std::chrono::steady_clock::now();
+	std::vector<std::thread> workers;
+	for (int t = 0; t < threads; ++t)
+	{
+		workers.emplace_back(
+			[&out, t]()
+			{
+				for (int i = 0; i < per_thread; ++i)
+				{
+					out->info("worker {0} message {1}", t, i);
+				}
+			});
+	}
+	for (auto& w : workers)
+	{
+		w.join();
+	}
+	const auto end = std::chrono::steady_clock::now();
+	out->flush();
+
+	const double ns = std::chrono::duration<double, std::nano>(end - begin).count() / (threads * per_thread);
+	const uint64_t dropped = mu::debug::logger()->dropped_messages();
+	std::fprintf(stderr, "%d messages through a 256-entry queue: %.0f ns/call, %llu dropped\n", threads * per_thread, ns, static_cast<unsigned long long>(dropped));
+
+	// Too late to change anything now.
+	const bool reconfigured = mu::debug::configure_logger(options);
+	return dropped == 0 && !reconfigured ? 0 : 1;
+}
@@ -0,0 +1,84 @@
+#include <mu_stdlib.h>
+
+#include <atomic>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+int main(int, char**)
+{
+	mu::time::init();
+
+	int failures = 0;
+
+	mu::time::long_clock clock;
+	clock.update();
+	const mu::time::moment base	 = clock.elapsed();
+	const mu::time::moment start = mu::time::now();
+
+	// Readers spin on the clock while the owner updates it as fast as it can; every read must be monotonic.
+	std::atomic<bool>		 done{false};
+	std::atomic<int64_t>	 reads{0};
+	std::atomic<int>		 regressions{0};
+	std::vector<std::thread> readers;
+	for (int r = 0; r < 3; ++r)
+	{
+		readers.emplace_back(
+			[&]()
+			{
+				mu::time::moment previous;
+				int64_t			 n = 0;
+				while (!done.load(std::memory_order_relaxed))
+				{
+					const mu::time::moment e = clock.elapsed();
+					if (e < previous || clock.elapsed_now() < e)
+					{
+						regressions.fetch_add(1);
+					}
+					previous = e;
+					++n;
+				}
+				reads.fetch_add(n);
+			});
+	}
+
+	// The old clock truncated every delta to whole milliseconds; track what it would have reported.
+	int64_t		   truncated_ms = 0;
+	int64_t		   updates		= 0;
+	const auto	   end			= start + mu::time::milliseconds(200);
+	int64_t		   last			= start.as_ticks<int64_t>();
+	mu::time::moment t;
+	while ((t = mu::time::now()) < end)
+	{
+		clock.update();
+		truncated_ms += mu::time::ticks(t.as_ticks<int64_t>() - last).as_milliseconds<int64_t>();
+		last = t.as_ticks<int64_t>();
+		++updates;
+	}
+	clock.update();
+	const mu::time::moment stop = mu::time::now();
+
+	done = true;
+	for (auto& reader : readers)
+	{
+		reader.join();
+	}
+
+	const double wall_ms  = (stop - start).as_microseconds<double>() / 1000.0;
+	const double clock_ms = (clock.elapsed() - base).as_microseconds<double>() / 1000.0;
+	printf(
+		"long_clock: %lld updates, wall %.3f ms, clock %.3f ms, truncating clock %lld ms, %lld reads, %d regressions\n",
+		static_cast<long long>(updates),
+		wall_ms,
+		clock_ms,
+		static_cast<long long>(truncated_ms),
+		static_cast<long long>(reads.load()),
+		regressions.load());
+
+	if (regressions.load() != 0 || clock_ms < wall_ms - 0.01 || clock_ms > wall_ms + 0.01)
+	{
+		++failures;
+	}
+
+	return failures == 0 ? 0 : 1;
+}
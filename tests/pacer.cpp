@@ -0,0 +1,112 @@
+#include <mu_stdlib_pacer.h>
+
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+namespace details
+{
+	void report(const char* name, const mu::time::pacer& p)
+	{
+		const auto s = p.stats();
+		printf(
+			"%-10s frames %lld, steps %lld, overruns %lld, skipped %lld, jitter mean %.1f us max %.1f us, max overrun %.1f us\n",
+			name,
+			static_cast<long long>(s.frames),
+			static_cast<long long>(p.step_count()),
+			static_cast<long long>(s.overruns),
+			static_cast<long long>(s.skipped),
+			s.mean_jitter.as_microseconds<double>(),
+			s.max_jitter.as_microseconds<double>(),
+			s.max_overrun.as_microseconds<double>());
+	}
+} // namespace details
+
+int main(int, char**)
+{
+	mu::time::init();
+
+	int failures = 0;
+
+	// Steady 1ms loop: 500 frames should take 500ms with no drift, whatever the per-frame error. On a loaded machine
+	// skip may still drop a step, which moves the schedule a whole period on by design; that isn't drift.
+	{
+		const mu::time::moment start = mu::time::now();
+		mu::time::pacer		   p(mu::time::milliseconds(1), mu::time::pacer_policy::skip, 4, start);
+		for (int i = 0; i < 500; ++i)
+		{
+			p.wait();
+		}
+		const mu::time::moment expected = mu::time::milliseconds(500 + p.stats().skipped);
+		const double		   drift_us = (mu::time::now() - start - expected).as_microseconds<double>();
+		details::report("steady", p);
+		printf("           drift after 500 frames %.1f us\n", drift_us);
+		if (drift_us < 0.0 || drift_us > 1000.0)
+		{
+			++failures;
+		}
+	}
+
+	// One 5.5ms stall in a 1ms loop, under each policy.
+	for (const auto policy : {mu::time::pacer_policy::catch_up, mu::time::pacer_policy::skip})
+	{
+		mu::time::pacer p(mu::time::milliseconds(1), policy, 3);
+		p.wait();
+		std::this_thread::sleep_for(std::chrono::microseconds(5500));
+		const uint32_t steps = p.wait();
+		p.wait();
+
+		const bool catch_up = policy == mu::time::pacer_policy::catch_up;
+		details::report(catch_up ? "catch_up" : "skip", p);
+		if (p.stats().overruns < 1 || steps != (catch_up ? 4u : 1u) || p.stats().skipped < (catch_up ? 1 : 4))
+		{
+			++failures;
+		}
+	}
+
+	// 1000 tokens/s with a burst of 10, drawn as fast as possible for 100ms.
+	{
+		mu::time::rate_limiter limiter(mu::time::milliseconds(1), 10);
+		const auto			   end		= mu::time::now() + mu::time::milliseconds(100);
+		int					   acquired = 0;
+		while (mu::time::now() < end)
+		{
+			acquired += limiter.try_acquire() ? 1 : 0;
+		}
+		printf("rate_limiter try_acquire: %d tokens in 100ms (expect ~110)\n", acquired);
+		if (acquired < 100 || acquired > 112)
+		{
+			++failures;
+		}
+	}
+
+	// Four threads sharing 1000 tokens/s through blocking acquire().
+	{
+		mu::time::rate_limiter	 limiter(mu::time::milliseconds(1), 1);
+		const mu::time::moment	 start = mu::time::now();
+		std::vector<std::thread> threads;
+		for (int t = 0; t < 4; ++t)
+		{
+			threads.emplace_back(
+				[&limiter]()
+				{
+					for (int i = 0; i < 50; ++i)
+					{
+						limiter.acquire();
+					}
+				});
+		}
+		for (auto& thread : threads)
+		{
+			thread.join();
+		}
+		const double elapsed_ms = (mu::time::now() - start).as_microseconds<double>() / 1000.0;
+		printf("rate_limiter acquire: 200 tokens across 4 threads in %.1f ms (expect ~199)\n", elapsed_ms);
+		if (elapsed_ms < 198.0 || elapsed_ms > 230.0)
+		{
+			++failures;
+		}
+	}
+
+	return failures == 0 ? 0 : 1;
+}
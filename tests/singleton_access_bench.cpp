@@ -0,0 +1,111 @@
+#include <mu_stdlib.h>
+
+#include <chrono>
+#include <cstdio>
+
+namespace details
+{
+	static constexpr int64_t iterations = 100000000;
+
+	struct counter
+	{
+		int64_t value = 0;
+	};
+
+	struct thread_counter
+	{
+		int64_t value = 0;
+	};
+
+	struct exported_counter
+	{
+		int64_t value = 0;
+	};
+
+	struct exported_thread_counter
+	{
+		int64_t value = 0;
+	};
+
+	// The accessor as it was: every construction checks the guard of a function-local static.
+	template<typename T>
+	class guarded_singleton
+	{
+	public:
+		auto operator->() noexcept -> T*
+		{
+			return s_instance;
+		}
+
+		guarded_singleton() noexcept
+		{
+			[[maybe_unused]] static bool static_init = []() -> bool
+			{
+				s_instance = new T();
+				return true;
+			}();
+		}
+
+	private:
+		static inline T* s_instance;
+	};
+
+	template<typename T>
+	class guarded_thread_local_singleton
+	{
+	public:
+		auto operator->() noexcept -> T*
+		{
+			return s_instance;
+		}
+
+		guarded_thread_local_singleton() noexcept
+		{
+			[[maybe_unused]] static thread_local bool static_init = []() -> bool
+			{
+				s_instance = new T();
+				return true;
+			}();
+		}
+
+	private:
+		static inline thread_local T* s_instance;
+	};
+
+	template<typename T_SINGLETON>
+	auto measure() -> double
+	{
+		T_SINGLETON()->value = 1;
+
+		int64_t	   sink	 = 0;
+		const auto begin = std::chrono::steady_clock::now();
+		for (int64_t i = 0; i < iterations; ++i)
+		{
+			sink += T_SINGLETON()->value;
+		}
+		const auto end = std::chrono::steady_clock::now();
+
+		if (sink != iterations)
+		{
+			printf("(sink)\n");
+		}
+		return std::chrono::duration<double, std::nano>(end - begin).count() / static_cast<double>(iterations);
+	}
+} // namespace details
+
+using exported_counter_singleton		= mu::exported_singleton<mu::singleton<details::exported_counter>>;
+using exported_thread_counter_singleton = mu::exported_thread_local_singleton<mu::thread_local_singleton<details::exported_thread_counter>>;
+
+MU_EXPORT_SINGLETON(exported_counter_singleton);
+MU_EXPORT_THREAD_LOCAL_SINGLETON(mu::thread_local_singleton<::details::exported_thread_counter>);
+
+int main(int, char**)
+{
+	printf("guarded singleton                %.3f ns/access\n", details::measure<details::guarded_singleton<details::counter>>());
+	printf("mu::singleton                    %.3f ns/access\n", details::measure<mu::singleton<details::counter>>());
+	printf("mu::exported_singleton           %.3f ns/access\n", details::measure<exported_counter_singleton>());
+	printf("guarded thread_local singleton   %.3f ns/access\n", details::measure<details::guarded_thread_local_singleton<details::thread_counter>>());
+	printf("mu::thread_local_singleton       %.3f ns/access\n", details::measure<mu::thread_local_singleton<details::thread_counter>>());
+	printf("mu::exported_thread_local_...    %.3f ns/access\n", details::measure<exported_thread_counter_singleton>());
+	return 0;
+}
@@ -0,0 +1,99 @@
+#include <mu_stdlib.h>
+
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace details
+{
+	static constexpr size_t entries_per_thread = 25000;
+	static constexpr size_t thread_count	   = 4;
+
+	struct record
+	{
+		std::vector<size_t> order;
+	};
+
+	struct tagged
+	{
+		record* r;
+		size_t	id;
+	};
+} // namespace details
+
+int main(int, char**)
+{
+	int failures = 0;
+
+	// Single thread: cleanups must run in exact reverse order, across many segment boundaries.
+	{
+		details::record					   r;
+		std::vector<details::tagged>	   tags(5000);
+		auto							   list	 = std::make_unique<mu::details::singleton_cleanup_list>();
+		const auto						   begin = std::chrono::steady_clock::now();
+		for (size_t i = 0; i < tags.size(); ++i)
+		{
+			tags[i] = {&r, i};
+			list->push(
+				[](void* context) noexcept
+				{
+					auto* t = static_cast<details::tagged*>(context);
+					t->r->order.push_back(t->id);
+				},
+				&tags[i]);
+		}
+		const auto end = std::chrono::steady_clock::now();
+		list.reset();
+
+		bool reversed = r.order.size() == tags.size();
+		for (size_t i = 0; reversed && i < r.order.size(); ++i)
+		{
+			reversed = r.order[i] == tags.size() - 1 - i;
+		}
+		printf("push: %.1f ns/entry, %zu cleanups ran in reverse order: %d\n", std::chrono::duration<double, std::nano>(end - begin).count() / tags.size(), r.order.size(), reversed ? 1 : 0);
+		if (!reversed)
+		{
+			++failures;
+		}
+	}
+
+	// Concurrent pushes: every entry is kept and run exactly once.
+	{
+		std::atomic<size_t> ran{0};
+		auto				list = std::make_unique<mu::details::singleton_cleanup_list>();
+
+		std::vector<std::thread> threads;
+		for (size_t t = 0; t < details::thread_count; ++t)
+		{
+			threads.emplace_back(
+				[&]()
+				{
+					for (size_t i = 0; i < details::entries_per_thread; ++i)
+					{
+						list->push(
+							[](void* context) noexcept
+							{
+								static_cast<std::atomic<size_t>*>(context)->fetch_add(1);
+							},
+							&ran);
+					}
+				});
+		}
+		for (auto& thread : threads)
+		{
+			thread.join();
+		}
+
+		const size_t pushed = list->size();
+		list.reset();
+		printf("concurrent: %zu pushed, %zu ran\n", pushed, ran.load());
+		if (pushed != details::entries_per_thread * details::thread_count || ran.load() != pushed)
+		{
+			++failures;
+		}
+	}
+
+	return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,113 @@
+#include <mu_stdlib_taskflow.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace details
+{
+	static std::mutex		 s_mutex;
+	static std::vector<char> s_constructed;
+	static std::vector<char> s_destroyed;
+
+	// Stands in for an expensive singleton (a logger opening files, a resolver loading symbols, ...).
+	template<char T_ID>
+	struct slow_singleton
+	{
+		slow_singleton()
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(50));
+			std::lock_guard<std::mutex> lock(s_mutex);
+			s_constructed.push_back(T_ID);
+		}
+
+		~slow_singleton()
+		{
+			std::lock_guard<std::mutex> lock(s_mutex);
+			s_destroyed.push_back(T_ID);
+		}
+	};
+
+	struct service_interface
+	{
+		virtual ~service_interface() = default;
+	};
+
+	struct service_impl : service_interface, slow_singleton<'v'>
+	{
+	};
+
+	auto position(const std::vector<char>& order, const char id) -> size_t
+	{
+		for (size_t i = 0; i < order.size(); ++i)
+		{
+			if (order[i] == id)
+			{
+				return i;
+			}
+		}
+		return order.size();
+	}
+
+	// a, b, c independent; d needs a and b; e needs d and c; v (virtual) needs a.
+	static const char s_edges[][2] = {{'d', 'a'}, {'d', 'b'}, {'e', 'd'}, {'e', 'c'}, {'v', 'a'}};
+
+	auto respects_edges(const std::vector<char>& order, const bool dependents_first) -> bool
+	{
+		for (const auto& edge : s_edges)
+		{
+			const size_t dependent	= position(order, edge[0]);
+			const size_t dependency = position(order, edge[1]);
+			if (dependent == order.size() || dependency == order.size() || (dependent < dependency) != dependents_first)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	void check_teardown()
+	{
+		printf("destroyed:   %.*s\n", static_cast<int>(s_destroyed.size()), s_destroyed.data());
+		if (s_destroyed.size() != 6 || !respects_edges(s_destroyed, true))
+		{
+			std::_Exit(1);
+		}
+	}
+} // namespace details
+
+using a_singleton = mu::singleton<details::slow_singleton<'a'>>;
+using b_singleton = mu::singleton<details::slow_singleton<'b'>>;
+using c_singleton = mu::singleton<details::slow_singleton<'c'>>;
+using d_singleton = mu::singleton<details::slow_singleton<'d'>, a_singleton, b_singleton>;
+using e_singleton = mu::singleton<details::slow_singleton<'e'>, d_singleton, c_singleton>;
+using v_singleton = mu::virtual_singleton<details::service_interface>;
+
+MU_DEFINE_VIRTUAL_SINGLETON_DEPS(::details::service_interface, ::details::service_impl, a_singleton);
+
+int main(int, char**)
+{
+	// Runs after the singleton cleanup list, which is registered on first construction.
+	std::atexit(details::check_teardown);
+
+	tf::Executor executor(4);
+
+	const auto begin = std::chrono::steady_clock::now();
+	mu::taskflow::initialize_singletons(executor);
+	const auto end = std::chrono::steady_clock::now();
+
+	// Everything is already built, so these are plain loads.
+	const bool all_built = e_singleton().get() != nullptr && v_singleton().get() != nullptr;
+
+	const double elapsed_ms = std::chrono::duration<double, std::milli>(end - begin).count();
+	printf("constructed: %.*s in %.1f ms (serial would be ~300 ms, critical path ~150 ms)\n", static_cast<int>(details::s_constructed.size()), details::s_constructed.data(), elapsed_ms);
+
+	if (!all_built || details::s_constructed.size() != 6 || !details::respects_edges(details::s_constructed, false) || elapsed_ms > 250.0)
+	{
+		return 1;
+	}
+	return 0;
+}
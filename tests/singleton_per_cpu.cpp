@@ -0,0 +1,88 @@
+#include <mu_stdlib.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+namespace details
+{
+	static constexpr int64_t iterations = 2000000;
+
+	struct counter
+	{
+		std::atomic<uint64_t> value{0};
+	};
+
+	struct shared_counter
+	{
+		std::atomic<uint64_t> value{0};
+	};
+
+	template<typename T_FUNC>
+	auto run(const uint32_t threads, T_FUNC func) -> double
+	{
+		const auto				 begin = std::chrono::steady_clock::now();
+		std::vector<std::thread> workers;
+		for (uint32_t t = 0; t < threads; ++t)
+		{
+			workers.emplace_back(
+				[func]()
+				{
+					for (int64_t i = 0; i < iterations; ++i)
+					{
+						func();
+					}
+				});
+		}
+		for (auto& w : workers)
+		{
+			w.join();
+		}
+		const auto end = std::chrono::steady_clock::now();
+		return std::chrono::duration<double, std::nano>(end - begin).count() / static_cast<double>(iterations * threads);
+	}
+} // namespace details
+
+using per_cpu_counter = mu::per_cpu_singleton<details::counter>;
+using shared_counter  = mu::singleton<details::shared_counter>;
+
+int main(int, char**)
+{
+	const uint32_t threads = std::max<uint32_t>(2, std::thread::hardware_concurrency());
+	const uint32_t shards  = per_cpu_counter().shard_count();
+
+	// Every shard on its own cache line.
+	uintptr_t previous = 0;
+	bool	  isolated = true;
+	per_cpu_counter().for_each(
+		[&](details::counter& c)
+		{
+			const uintptr_t address = reinterpret_cast<uintptr_t>(&c);
+			isolated				= isolated && address % 64 == 0 && (previous == 0 || address - previous >= 64);
+			previous				= address;
+		});
+
+	const double shared_ns = details::run(threads,
+										  []()
+										  {
+											  shared_counter()->value.fetch_add(1, std::memory_order_relaxed);
+										  });
+	const double per_cpu_ns = details::run(threads,
+										   []()
+										   {
+											   per_cpu_counter()->value.fetch_add(1, std::memory_order_relaxed);
+										   });
+
+	const uint64_t total = per_cpu_counter().accumulate(uint64_t(0),
+														[](const uint64_t sum, const details::counter& c)
+														{
+															return sum + c.value.load(std::memory_order_relaxed);
+														});
+
+	printf("%u threads, %u shards: shared atomic %.2f ns/inc, per-cpu %.2f ns/inc, total %llu\n", threads, shards, shared_ns, per_cpu_ns,
+		   static_cast<unsigned long long>(total));
+
+	return isolated && total == static_cast<uint64_t>(details::iterations) * threads ? 0 : 1;
+}
@@ -0,0 +1,149 @@
+#include <mu_stdlib.h>
+
+#include <cstdio>
+#include <thread>
+
+namespace details
+{
+	// Written on every request from every thread: wants its own cache lines.
+	struct request_counters
+	{
+		static constexpr mu::singleton_placement singleton_placement = mu::singleton_placement::isolated;
+
+		std::atomic<uint64_t> requests{0};
+		std::atomic<uint64_t> errors{0};
+	};
+
+	struct error_counters
+	{
+		static constexpr mu::singleton_placement singleton_placement = mu::singleton_placement::isolated;
+
+		std::atomic<uint64_t> count{0};
+	};
+
+	// Read-mostly configuration: pack them together.
+	struct limits
+	{
+		static constexpr mu::singleton_placement singleton_placement = mu::singleton_placement::packed;
+
+		uint32_t max_connections = 1024;
+	};
+
+	struct paths
+	{
+		static constexpr mu::singleton_placement singleton_placement = mu::singleton_placement::packed;
+
+		const char* root = "/";
+	};
+
+	// Per thread, recycled: the pool has to hand instances back to the arena, not to delete.
+	struct scratch
+	{
+		static constexpr mu::singleton_placement singleton_placement = mu::singleton_placement::isolated;
+
+		int used = 0;
+	};
+
+	struct plain
+	{
+		int value = 7;
+	};
+
+	// A user-supplied policy, counting what goes through it.
+	struct counting_allocator
+	{
+		static inline int allocations	= 0;
+		static inline int deallocations = 0;
+
+		static auto allocate(const size_t size, const size_t alignment) noexcept -> void*
+		{
+			++allocations;
+			return mu::heap_singleton_allocator::allocate(size, alignment);
+		}
+
+		static void deallocate(void* p, const size_t size, const size_t alignment) noexcept
+		{
+			++deallocations;
+			mu::heap_singleton_allocator::deallocate(p, size, alignment);
+		}
+	};
+
+	auto line_of(const void* p) -> uintptr_t
+	{
+		return reinterpret_cast<uintptr_t>(p) / 64;
+	}
+} // namespace details
+
+int main(int, char**)
+{
+	mu::singletons::configure_arena(64 * 1024, true);
+
+	int failures = 0;
+
+	const void* requests = mu::singleton<details::request_counters>().get();
+	const void* errors	 = mu::singleton<details::error_counters>().get();
+	const void* limits	 = mu::singleton<details::limits>().get();
+	const void* paths	 = mu::singleton<details::paths>().get();
+	const void* plain	 = mu::singleton<details::plain>().get();
+	const void* custom	 = mu::allocated_singleton<details::plain, details::counting_allocator>().get();
+
+	const auto info = mu::singletons::get_arena_info();
+	printf(
+		"arena %p: %zu bytes, %zu packed, %zu isolated, huge pages %d\n",
+		info.base,
+		info.capacity,
+		info.packed_used,
+		info.isolated_used,
+		info.huge_pages ? 1 : 0);
+	printf("isolated %p %p, packed %p %p, heap %p, custom %p\n", requests, errors, limits, paths, plain, custom);
+
+	const bool isolated_ok = mu::details::singleton_arena_contains(requests) && mu::details::singleton_arena_contains(errors) &&
+							 reinterpret_cast<uintptr_t>(requests) % 64 == 0 && reinterpret_cast<uintptr_t>(errors) % 64 == 0 &&
+							 details::line_of(requests) != details::line_of(errors) && details::line_of(limits) != details::line_of(requests) &&
+							 details::line_of(paths) != details::line_of(errors);
+	const bool packed_ok = mu::details::singleton_arena_contains(limits) && mu::details::singleton_arena_contains(paths) &&
+						   details::line_of(limits) == details::line_of(paths);
+	const bool heap_ok = !mu::details::singleton_arena_contains(plain) && !mu::details::singleton_arena_contains(custom) && details::counting_allocator::allocations == 1;
+
+	if (!isolated_ok || !packed_ok || !heap_ok || info.isolated_used != 128)
+	{
+		printf("isolated %d, packed %d, heap %d\n", isolated_ok ? 1 : 0, packed_ok ? 1 : 0, heap_ok ? 1 : 0);
+		++failures;
+	}
+
+	// Two threads at once overflow a pool of one, so one instance is destroyed straight away; the other is reused
+	// by the next thread, and destroyed with the pool at exit.
+	using recycled_scratch = mu::recycled_thread_local_singleton<details::scratch, 1>;
+	const void*		 first[2]	= {};
+	std::atomic<int> holding{0};
+	{
+		const auto hold = [&first, &holding](const int i)
+		{
+			first[i] = recycled_scratch().get();
+			holding.fetch_add(1);
+			while (holding.load() < 2)
+			{
+				std::this_thread::yield();
+			}
+		};
+		std::thread a(hold, 0);
+		std::thread b(hold, 1);
+		a.join();
+		b.join();
+	}
+	const void* reused = nullptr;
+	std::thread(
+		[&reused]()
+		{
+			reused = recycled_scratch().get();
+		})
+		.join();
+
+	printf("recycled %p %p, reused %p\n", first[0], first[1], reused);
+	if (!mu::details::singleton_arena_contains(first[0]) || !mu::details::singleton_arena_contains(first[1]) || first[0] == first[1] || (reused != first[0] && reused != first[1]))
+	{
+		++failures;
+	}
+
+	return failures == 0 ? 0 : 1;
+}
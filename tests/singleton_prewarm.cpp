@@ -0,0 +1,100 @@
+#include <mu_stdlib.h>
+
+#include <chrono>
+#include <cstdio>
+#include <string_view>
+#include <thread>
+
+namespace details
+{
+	static int s_constructed = 0;
+
+	template<int T_MILLISECONDS>
+	struct slow
+	{
+		slow()
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(T_MILLISECONDS));
+			++s_constructed;
+		}
+	};
+
+	struct config : slow<20>
+	{
+		static constexpr std::string_view singleton_group = "startup";
+	};
+
+	struct database : slow<30>
+	{
+		static constexpr std::string_view singleton_group = "startup";
+	};
+
+	struct cache : slow<10>
+	{
+	};
+} // namespace details
+
+using config_singleton	 = mu::singleton<details::config>;
+using database_singleton = mu::singleton<details::database, config_singleton>;
+using cache_singleton	 = mu::singleton<details::cache>;
+
+auto find(const std::vector<mu::singletons::report_entry>& entries, const std::string_view name) -> const mu::singletons::report_entry*
+{
+	for (const auto& entry : entries)
+	{
+		if (entry.name.find(name) != std::string_view::npos)
+		{
+			return &entry;
+		}
+	}
+	return nullptr;
+}
+
+// Never called: using the accessors anywhere is enough to register them, and nothing is built until prewarm().
+[[maybe_unused]] static void use_singletons()
+{
+	(void)cache_singleton().get();
+	(void)database_singleton().get();
+}
+
+int main(int, char**)
+{
+	if (details::s_constructed != 0)
+	{
+		return 1;
+	}
+
+	const std::string_view groups[] = {"startup"};
+	mu::singletons::prewarm(groups);
+	printf("after prewarm(startup): %d constructed\n", details::s_constructed);
+	if (details::s_constructed != 2)
+	{
+		return 1;
+	}
+
+	auto entries = mu::singletons::report();
+	mu::singletons::log_report(*mu::debug::logger()->stdout_logger(), spdlog::level::info);
+
+	const auto* database = find(entries, "database");
+	const auto* config	 = find(entries, "config");
+	const auto* cache	 = find(entries, "cache");
+	if (database == nullptr || config == nullptr || cache == nullptr || !database->constructed || !config->constructed || cache->constructed)
+	{
+		return 1;
+	}
+
+	// The database's own cost excludes the config it waited for; its chain includes it.
+	const double own   = database->cost.as_milliseconds<double>();
+	const double chain = database->chain_cost.as_milliseconds<double>();
+	printf("database: %.1f ms own, %.1f ms chain, %zu on critical chain\n", own, chain, database->critical_chain.size());
+	if (own < 25.0 || own > 45.0 || chain < 45.0 || database->critical_chain.size() != 2 || database->critical_chain[1] != config->name)
+	{
+		return 1;
+	}
+
+	mu::singletons::prewarm();
+	entries = mu::singletons::report();
+	cache	= find(entries, "cache");
+	printf("after prewarm(): %d constructed\n", details::s_constructed);
+	return details::s_constructed == 3 && cache != nullptr && cache->constructed ? 0 : 1;
+}
@@ -0,0 +1,106 @@
+#include <mu_stdlib.h>
+
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+namespace details
+{
+	static std::atomic<int> s_created{0};
+	static std::atomic<int> s_destroyed{0};
+
+	struct routing_table
+	{
+		routing_table()
+		{
+			s_created.fetch_add(1);
+		}
+
+		virtual ~routing_table()
+		{
+			// Poison it so a reader that was handed a freed table notices.
+			alive.store(false, std::memory_order_relaxed);
+			s_destroyed.fetch_add(1);
+		}
+
+		virtual auto version() const -> int = 0;
+
+		std::atomic<bool> alive{true};
+	};
+
+	struct static_routes : routing_table
+	{
+		auto version() const -> int override
+		{
+			return 0;
+		}
+	};
+
+	struct reloaded_routes : routing_table
+	{
+		explicit reloaded_routes(const int v)
+			: m_version(v)
+		{
+		}
+
+		auto version() const -> int override
+		{
+			return m_version;
+		}
+
+		int m_version;
+	};
+} // namespace details
+
+using routes = mu::swappable_virtual_singleton<::details::routing_table>;
+MU_DEFINE_VIRTUAL_SINGLETON(::details::routing_table, ::details::static_routes);
+
+int main(int, char**)
+{
+	static constexpr int reloads = 2000;
+
+	std::atomic<bool> stop{false};
+	std::atomic<bool> failed{false};
+	std::atomic<long> reads{0};
+
+	std::vector<std::thread> readers;
+	for (int t = 0; t < 3; ++t)
+	{
+		readers.emplace_back(
+			[&]()
+			{
+				int	 last  = 0;
+				long count = 0;
+				while (!stop.load(std::memory_order_relaxed))
+				{
+					routes r;
+					const int v = r->version();
+					std::this_thread::yield(); // Hold it across a reload or two.
+					if (!r->alive.load(std::memory_order_relaxed) || v < last)
+					{
+						failed.store(true);
+					}
+					last = v;
+					++count;
+				}
+				reads.fetch_add(count);
+			});
+	}
+
+	for (int v = 1; v <= reloads; ++v)
+	{
+		routes::emplace<details::reloaded_routes>(v);
+		std::this_thread::yield();
+	}
+	stop.store(true);
+	for (auto& r : readers)
+	{
+		r.join();
+	}
+
+	const int version = routes()->version();
+	mu::singletons::synchronize();
+
+	printf("%d reloads, %ld reads, version %d, %d created, %d destroyed\n", reloads, reads.load(), version, details::s_created.load(), details::s_destroyed.load());
+	return !failed.load() && version == reloads && details::s_destroyed.load() == details::s_created.load() - 1 ? 0 : 1;
+}
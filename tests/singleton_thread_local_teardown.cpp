@@ -0,0 +1,123 @@
+#include <mu_stdlib.h>
+
+#include <atomic>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+namespace details
+{
+	static std::atomic<int> s_constructed{0};
+	static std::atomic<int> s_destroyed{0};
+	static std::atomic<int> s_recycled{0};
+
+	struct per_thread_state
+	{
+		per_thread_state()
+		{
+			s_constructed.fetch_add(1);
+		}
+
+		~per_thread_state()
+		{
+			s_destroyed.fetch_add(1);
+		}
+
+		int uses = 0;
+	};
+
+	// A scratch buffer worth keeping: recycling clears it but keeps the allocation.
+	struct scratch_buffer
+	{
+		scratch_buffer()
+		{
+			s_constructed.fetch_add(1);
+		}
+
+		~scratch_buffer()
+		{
+			s_destroyed.fetch_add(1);
+		}
+
+		void recycle()
+		{
+			bytes.clear();
+			s_recycled.fetch_add(1);
+		}
+
+		std::vector<char> bytes;
+	};
+
+	void reset_counts()
+	{
+		s_constructed = 0;
+		s_destroyed	  = 0;
+		s_recycled	  = 0;
+	}
+} // namespace details
+
+using per_thread_singleton = mu::thread_local_singleton<details::per_thread_state>;
+using scratch_singleton	   = mu::recycled_thread_local_singleton<details::scratch_buffer, 4>;
+
+int main(int, char**)
+{
+	int failures = 0;
+
+	// Every thread that touches a thread_local_singleton gets its own instance, destroyed when it exits.
+	{
+		details::reset_counts();
+		for (int round = 0; round < 4; ++round)
+		{
+			std::vector<std::thread> threads;
+			for (int t = 0; t < 4; ++t)
+			{
+				threads.emplace_back(
+					[]()
+					{
+						per_thread_singleton()->uses++;
+					});
+			}
+			for (auto& thread : threads)
+			{
+				thread.join();
+			}
+		}
+		printf("thread_local_singleton: %d constructed, %d destroyed\n", details::s_constructed.load(), details::s_destroyed.load());
+		if (details::s_constructed.load() != 16 || details::s_destroyed.load() != 16)
+		{
+			++failures;
+		}
+	}
+
+	// Threads exiting hand their scratch buffer to the next thread instead of freeing it.
+	{
+		details::reset_counts();
+		size_t reused_capacity = 0;
+		for (int round = 0; round < 8; ++round)
+		{
+			std::thread(
+				[&reused_capacity]()
+				{
+					scratch_singleton s;
+					if (s->bytes.capacity() >= 4096)
+					{
+						++reused_capacity;
+					}
+					s->bytes.resize(4096);
+				})
+				.join();
+		}
+		printf(
+			"recycled_thread_local_singleton: %d constructed, %d recycled, %zu threads started with a warm buffer, %d destroyed\n",
+			details::s_constructed.load(),
+			details::s_recycled.load(),
+			reused_capacity,
+			details::s_destroyed.load());
+		if (details::s_constructed.load() != 1 || details::s_recycled.load() != 7 || reused_capacity != 7 || details::s_destroyed.load() != 0)
+		{
+			++failures;
+		}
+	}
+
+	return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,53 @@
+#include <mu_stdlib.h>
+
+#include <spdlog/sinks/null_sink.h>
+
+#include <chrono>
+#include <cstdio>
+
+namespace details
+{
+	MU_NOINLINE auto capture_here() -> mu::debug::stack_capture
+	{
+		return mu::debug::capture_stack_trace();
+	}
+
+	template<typename T_FUNC>
+	auto us(T_FUNC func) -> double
+	{
+		const auto begin = std::chrono::steady_clock::now();
+		func();
+		return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - begin).count();
+	}
+} // namespace details
+
+int main(int, char**)
+{
+	spdlog::logger sink("null", std::make_shared<spdlog::sinks::null_sink_mt>());
+	mu::debug::load_symbols().wait();
+
+	// One call site, logged repeatedly: the first pass resolves every frame, the rest find them all cached.
+	mu::debug::stack_capture	  trace;
+	double						  capture_us = 0;
+	double						  log_us[3]	 = {};
+	mu::debug::symbol_cache_stats stats[3];
+	for (int pass = 0; pass < 3; ++pass)
+	{
+		capture_us = details::us(
+			[&]()
+			{
+				trace = details::capture_here();
+			});
+		log_us[pass] = details::us(
+			[&]()
+			{
+				mu::debug::log_stack_trace(sink, spdlog::level::warn, trace);
+			});
+		stats[pass] = mu::debug::get_symbol_cache_stats();
+	}
+
+	printf("%u frames: capture %.1f us, first log %.1f us, repeats %.1f / %.1f us (%llu resolved, %llu cached)\n", trace.size, capture_us, log_us[0], log_us[1], log_us[2],
+		   static_cast<unsigned long long>(stats[2].misses), static_cast<unsigned long long>(stats[2].hits));
+
+	return trace.size != 0 && stats[0].misses == trace.size && stats[2].misses == stats[0].misses && stats[2].hits == 2ull * trace.size ? 0 : 1;
+}
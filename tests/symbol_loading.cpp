@@ -0,0 +1,49 @@
+#include <mu_stdlib.h>
+
+#include <spdlog/sinks/ostream_sink.h>
+
+#include <chrono>
+#include <cstdio>
+#include <sstream>
+#include <string>
+
+namespace details
+{
+	// Logs a trace of this call and returns whether every line was a bare address.
+	auto log_raw_only(spdlog::logger& l, std::ostringstream& out) -> bool
+	{
+		out.str("");
+		mu::debug::log_stack_trace(l, spdlog::level::warn, 0);
+
+		std::istringstream lines(out.str());
+		bool			   raw = true;
+		for (std::string line; std::getline(lines, line);)
+		{
+			raw = raw && !line.empty() && line.front() == '[';
+		}
+		return raw;
+	}
+} // namespace details
+
+int main(int, char**)
+{
+	std::ostringstream out;
+	spdlog::logger	   l("capture", std::make_shared<spdlog::sinks::ostream_sink_mt>(out));
+	l.set_pattern("%v");
+
+	// Building the logger starts the load; it shouldn't wait for it, and neither should a trace logged straight after.
+	const auto begin = std::chrono::steady_clock::now();
+	mu::debug::logger();
+	const bool early_raw = details::log_raw_only(l, out);
+	const auto elapsed	 = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+
+	auto	   ready	   = mu::debug::load_symbols();
+	const bool was_loading = ready.wait_for(std::chrono::seconds(0)) != std::future_status::ready;
+	const bool loaded	   = ready.get();
+	const bool late_raw	   = details::log_raw_only(l, out);
+
+	printf("logger + first trace %.2f ms (%s), loaded %s, then %s\n", elapsed, early_raw ? "raw" : "resolved", loaded ? "ok" : "failed", late_raw ? "raw" : "resolved");
+
+	// Only a load still running after the first trace proves that trace didn't wait; if it had finished, either is fine.
+	return (!was_loading || early_raw) && loaded && !late_raw ? 0 : 1;
+}
@@ -0,0 +1,123 @@
+#include <mu_stdlib.h>
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace details
+{
+	static constexpr size_t sample_count = 1 << 16;
+	static constexpr int	rounds		 = 64;
+
+	// The conversion moment::as_nanoseconds() used before the fixed-point tables.
+	template<typename T>
+	inline auto legacy_as_nanoseconds(const int64_t value) noexcept -> T
+	{
+		return static_cast<T>(
+			static_cast<long double>(value) / ((static_cast<long double>(mu::time::performance_frequency()) / static_cast<long double>(1000ull * 1000ull * 1000ull))));
+	}
+
+	template<typename T>
+	inline auto legacy_set_microseconds(const T& us) noexcept -> int64_t
+	{
+		return static_cast<int64_t>((static_cast<long double>(mu::time::performance_frequency()) / static_cast<long double>(1000ull * 1000ull)) * static_cast<long double>(us));
+	}
+
+	template<typename T_FUNC>
+	auto measure(const std::vector<int64_t>& samples, T_FUNC func) -> double
+	{
+		int64_t sink = 0;
+
+		const auto begin = std::chrono::steady_clock::now();
+		for (int r = 0; r < rounds; ++r)
+		{
+			for (const int64_t v : samples)
+			{
+				sink += func(v);
+			}
+		}
+		const auto end = std::chrono::steady_clock::now();
+
+		if (sink == 0)
+		{
+			printf("(sink)\n");
+		}
+		return std::chrono::duration<double, std::nano>(end - begin).count() / static_cast<double>(rounds * samples.size());
+	}
+
+	// r must satisfy r * denominator <= v * numerator < (r + 1) * denominator.
+	auto count_inexact(const mu::time::details::tick_conversion& c, const std::vector<int64_t>& samples) -> size_t
+	{
+		using mu::time::details::mul_64x64;
+
+		size_t inexact = 0;
+		for (const int64_t v : samples)
+		{
+			const uint64_t r	 = c.apply(static_cast<uint64_t>(v));
+			const auto	   exact = mul_64x64(static_cast<uint64_t>(v), c.numerator);
+			if (exact < mul_64x64(r, c.denominator) || !(exact < mul_64x64(r + 1, c.denominator)))
+			{
+				++inexact;
+			}
+		}
+		return inexact;
+	}
+} // namespace details
+
+int main(int, char**)
+{
+	mu::time::init();
+	mu::time::set_tick_source(mu::time::tick_source::tsc);
+
+	std::mt19937_64		 rng(42);
+	std::vector<int64_t> samples(details::sample_count);
+	for (auto& s : samples)
+	{
+		// Spread across magnitudes from a few ticks up to ~days of uptime.
+		s = static_cast<int64_t>(rng() >> (16 + (rng() % 44)));
+	}
+
+	const double fixed_to_ns = details::measure(
+		samples,
+		[](int64_t v)
+		{
+			return mu::time::ticks(v).as_nanoseconds<int64_t>();
+		});
+	const double legacy_to_ns = details::measure(
+		samples,
+		[](int64_t v)
+		{
+			return details::legacy_as_nanoseconds<int64_t>(v);
+		});
+	const double fixed_from_us = details::measure(
+		samples,
+		[](int64_t v)
+		{
+			return mu::time::microseconds(v & 0xffffffffll).as_ticks<int64_t>();
+		});
+	const double legacy_from_us = details::measure(
+		samples,
+		[](int64_t v)
+		{
+			return details::legacy_set_microseconds(v & 0xffffffffll);
+		});
+
+	printf("frequency %lld Hz\n", static_cast<long long>(mu::time::performance_frequency()));
+	printf("as_nanoseconds<int64_t>   fixed-point %.2f ns, long double %.2f ns\n", fixed_to_ns, legacy_to_ns);
+	printf("set_microseconds(int64_t) fixed-point %.2f ns, long double %.2f ns\n", fixed_from_us, legacy_from_us);
+
+	size_t inexact = 0;
+	for (const int64_t frequency : {int64_t{1000000000}, int64_t{10000000}, int64_t{24000000}, int64_t{2099935334}, mu::time::performance_frequency()})
+	{
+		const mu::time::details::tick_conversions c{frequency};
+		inexact += details::count_inexact(c.to_nanoseconds, samples);
+		inexact += details::count_inexact(c.to_microseconds, samples);
+		inexact += details::count_inexact(c.to_seconds, samples);
+		inexact += details::count_inexact(c.from_microseconds, samples);
+	}
+	printf("inexact integer conversions: %zu\n", inexact);
+
+	mu::time::set_tick_source(mu::time::tick_source::os_monotonic);
+	return inexact == 0 ? 0 : 1;
+}
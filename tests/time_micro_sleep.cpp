@@ -0,0 +1,44 @@
+#include <mu_stdlib.h>
+
+#include <cstdio>
+#include <ctime>
+
+int main(int, char**)
+{
+	mu::time::init();
+	mu::time::calibrate();
+
+	const std::clock_t cpu_begin  = std::clock();
+	const auto		  wall_begin = mu::time::now();
+
+	for (int i = 0; i < 500; ++i)
+	{
+		mu::time::micro_sleep_microseconds(500 + (i % 10) * 100);
+	}
+
+	const double cpu_ms	 = 1000.0 * static_cast<double>(std::clock() - cpu_begin) / CLOCKS_PER_SEC;
+	const double wall_ms = (mu::time::now() - wall_begin).as_milliseconds<double>();
+
+	const auto stats = mu::time::get_micro_sleep_stats();
+	printf(
+		"%lld sleeps (%lld blocked), wall %.1f ms, cpu %.1f ms (%.1f%%)\n",
+		static_cast<long long>(stats.sleeps),
+		static_cast<long long>(stats.blocked),
+		wall_ms,
+		cpu_ms,
+		100.0 * cpu_ms / wall_ms);
+	printf(
+		"spin slice %lld ns, wake latency %lld ns, max late %lld ns\n",
+		static_cast<long long>(stats.spin_slice_ns),
+		static_cast<long long>(stats.wake_latency_ns),
+		static_cast<long long>(stats.max_late_ns));
+
+	for (size_t i = 0; i < stats.late_histogram.size(); ++i)
+	{
+		if (stats.late_histogram[i] > 0)
+		{
+			printf("  late < %8lld us: %lld\n", 1ll << i, static_cast<long long>(stats.late_histogram[i]));
+		}
+	}
+	return 0;
+}
@@ -0,0 +1,104 @@
+#include <mu_stdlib.h>
+
+#include <chrono>
+#include <cstdio>
+
+namespace details
+{
+	static constexpr int64_t iterations = 10000000;
+
+	auto measure_get_now() -> double
+	{
+		int64_t sink = 0;
+
+		const auto begin = std::chrono::steady_clock::now();
+		for (int64_t i = 0; i < iterations; ++i)
+		{
+			sink += mu::time::get_now();
+		}
+		const auto end = std::chrono::steady_clock::now();
+
+		if (sink == 0)
+		{
+			printf("(sink)\n");
+		}
+		return std::chrono::duration<double, std::nano>(end - begin).count() / static_cast<double>(iterations);
+	}
+
+	auto measure_moment_now() -> double
+	{
+		mu::time::moment sink;
+
+		const auto begin = std::chrono::steady_clock::now();
+		for (int64_t i = 0; i < iterations; ++i)
+		{
+			sink += mu::time::now();
+		}
+		const auto end = std::chrono::steady_clock::now();
+
+		if (sink.as_ticks<int64_t>() == 0)
+		{
+			printf("(sink)\n");
+		}
+		return std::chrono::duration<double, std::nano>(end - begin).count() / static_cast<double>(iterations);
+	}
+
+	auto measure_coarse_now() -> double
+	{
+		mu::time::moment sink;
+
+		const auto begin = std::chrono::steady_clock::now();
+		for (int64_t i = 0; i < iterations; ++i)
+		{
+			sink += mu::time::coarse_now();
+		}
+		const auto end = std::chrono::steady_clock::now();
+
+		if (sink.as_ticks<int64_t>() == 0)
+		{
+			printf("(sink)\n");
+		}
+		return std::chrono::duration<double, std::nano>(end - begin).count() / static_cast<double>(iterations);
+	}
+
+	void report(const char* name, mu::time::tick_source source)
+	{
+		if (!mu::time::set_tick_source(source))
+		{
+			printf("%-14s unavailable\n", name);
+			return;
+		}
+
+		const double get_now_ns	   = measure_get_now();
+		const double moment_now_ns = measure_moment_now();
+		printf("%-14s frequency %lld Hz, get_now %.2f ns/call, now() %.2f ns/call\n", name, static_cast<long long>(mu::time::performance_frequency()), get_now_ns, moment_now_ns);
+	}
+} // namespace details
+
+int main(int, char**)
+{
+	mu::time::init();
+
+	details::report("os_monotonic", mu::time::tick_source::os_monotonic);
+	details::report("tsc", mu::time::tick_source::tsc);
+
+	mu::time::calibrate();
+	const auto info = mu::time::get_calibration_info();
+	printf(
+		"calibrate() chose %s: frequency %lld Hz, tsc %lld Hz, invariant %d, skew %lld ns, get_now %.2f ns/call\n",
+		info.source == mu::time::tick_source::tsc ? "tsc" : "os_monotonic",
+		static_cast<long long>(info.frequency),
+		static_cast<long long>(info.tsc_frequency),
+		info.invariant_tsc ? 1 : 0,
+		static_cast<long long>(info.tsc_skew_ns),
+		details::measure_get_now());
+
+	mu::time::start_coarse_clock(mu::time::milliseconds(1));
+	const double coarse_ns = details::measure_coarse_now();
+	const double staleness = (mu::time::now() - mu::time::coarse_now()).as_microseconds<double>();
+	mu::time::stop_coarse_clock();
+	printf("coarse_now()   %.2f ns/call, %.1f us behind now()\n", coarse_ns, staleness);
+
+	mu::time::set_tick_source(mu::time::tick_source::os_monotonic);
+	return 0;
+}
@@ -0,0 +1,153 @@
+#include <mu_stdlib_timer_wheel.h>
+
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <queue>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace details
+{
+	static constexpr uint32_t timer_count = 1000000;
+
+	using clock = std::chrono::steady_clock;
+
+	auto ns_per(const clock::time_point begin, const clock::time_point end, const size_t count) -> double
+	{
+		return std::chrono::duration<double, std::nano>(end - begin).count() / static_cast<double>(count);
+	}
+} // namespace details
+
+int main(int, char**)
+{
+	mu::time::init();
+
+	const mu::time::moment start	  = mu::time::now();
+	const mu::time::moment resolution = mu::time::milliseconds(1);
+	const int64_t		   span		  = mu::time::seconds(10).as_ticks<int64_t>();
+	const int64_t		   step		  = resolution.as_ticks<int64_t>();
+
+	std::mt19937_64		 rng(7);
+	std::vector<int64_t> deadlines(details::timer_count);
+	for (auto& d : deadlines)
+	{
+		d = start.as_ticks<int64_t>() + static_cast<int64_t>(rng() % static_cast<uint64_t>(span));
+	}
+
+	int failures = 0;
+
+	// Single-threaded: schedule 1M, cancel every other one, then sweep the clock across the whole span.
+	{
+		mu::time::timer_wheel<int64_t>						 wheel(resolution, details::timer_count, start);
+		std::vector<mu::time::timer_wheel<int64_t>::handle> handles(details::timer_count);
+
+		const auto schedule_begin = details::clock::now();
+		for (uint32_t i = 0; i < details::timer_count; ++i)
+		{
+			handles[i] = wheel.schedule(mu::time::ticks(deadlines[i]), deadlines[i]);
+		}
+		const auto schedule_end = details::clock::now();
+
+		for (uint32_t i = 0; i < details::timer_count; i += 2)
+		{
+			wheel.cancel(handles[i]);
+		}
+		const auto cancel_end = details::clock::now();
+
+		size_t	fired	 = 0;
+		int64_t max_late = 0;
+		for (int64_t t = start.as_ticks<int64_t>(); t <= start.as_ticks<int64_t>() + span + 2 * step; t += step)
+		{
+			fired += wheel.advance(
+				mu::time::ticks(t),
+				[&](int64_t deadline)
+				{
+					if (deadline > t)
+					{
+						++failures;
+					}
+					max_late = std::max(max_late, t - deadline);
+				});
+		}
+		const auto advance_end = details::clock::now();
+
+		printf(
+			"timer_wheel: schedule %.1f ns, cancel %.1f ns, expire %.1f ns/timer, fired %zu, max late %.3f ms\n",
+			details::ns_per(schedule_begin, schedule_end, details::timer_count),
+			details::ns_per(schedule_end, cancel_end, details::timer_count / 2),
+			details::ns_per(cancel_end, advance_end, fired),
+			fired,
+			mu::time::ticks(max_late).as_microseconds<double>() / 1000.0);
+
+		if (fired != details::timer_count / 2 || wheel.size() != 0 || max_late > 2 * step)
+		{
+			++failures;
+		}
+	}
+
+	// Baseline: the same deadlines through a binary heap.
+	{
+		std::priority_queue<int64_t, std::vector<int64_t>, std::greater<int64_t>> heap;
+
+		const auto push_begin = details::clock::now();
+		for (const int64_t d : deadlines)
+		{
+			heap.push(d);
+		}
+		const auto push_end = details::clock::now();
+
+		size_t fired = 0;
+		while (!heap.empty())
+		{
+			heap.pop();
+			++fired;
+		}
+		const auto pop_end = details::clock::now();
+
+		printf(
+			"binary heap: push %.1f ns, pop %.1f ns/timer\n",
+			details::ns_per(push_begin, push_end, details::timer_count),
+			details::ns_per(push_end, pop_end, fired));
+	}
+
+	// Four producer threads inserting remotely while the owner drains.
+	{
+		mu::time::timer_wheel<int64_t> wheel(resolution, details::timer_count, start);
+
+		const auto				 remote_begin = details::clock::now();
+		std::vector<std::thread> producers;
+		for (uint32_t p = 0; p < 4; ++p)
+		{
+			producers.emplace_back(
+				[&, p]()
+				{
+					for (uint32_t i = p; i < details::timer_count; i += 4)
+					{
+						wheel.schedule_remote(mu::time::ticks(deadlines[i]), deadlines[i]);
+					}
+				});
+		}
+
+		size_t fired = 0;
+		for (auto& producer : producers)
+		{
+			producer.join();
+		}
+		fired += wheel.advance(
+			mu::time::ticks(start.as_ticks<int64_t>() + span + 2 * step),
+			[](int64_t) {
+			});
+		const auto remote_end = details::clock::now();
+
+		printf("timer_wheel remote: schedule + expire %.1f ns/timer, fired %zu\n", details::ns_per(remote_begin, remote_end, details::timer_count), fired);
+
+		if (fired != details::timer_count)
+		{
+			++failures;
+		}
+	}
+
+	return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,22 @@
+#include <mu_stdlib_binlog.h>
+
+#include <cstdio>
+
+// Formats a capture written with mu::debug::logger_options::binary_path to stdout.
+//
+//     mu_binlog_decode run.mubin
+int main(int argc, char** argv)
+{
+	if (argc != 2)
+	{
+		std::fprintf(stderr, "usage: %s <capture>\n", argv[0]);
+		return 2;
+	}
+
+	if (!mu::binlog::decode_file(argv[1], *mu::debug::logger()->stdout_logger()))
+	{
+		std::fprintf(stderr, "%s: not a readable binlog capture\n", argv[1]);
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,136 @@
+#include <mu_stdlib_crash.h>
+
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <string>
+
+#ifdef _WIN32
+#define popen  _popen
+#define pclose _pclose
+#endif
+
+// Prints a dump written by mu::crash::install() as a readable trace. Frames are resolved by running an
+// addr2line-compatible symbolizer on the module each falls in: addr2line for ELF, llvm-addr2line for Mach-O and
+// PE/PDB. The modules must be the builds that crashed; compare the build ids listed.
+//
+//     mu_crash_symbolize crash-1234.mudump [symbolizer, default addr2line]
+namespace details
+{
+	auto describe(const mu::crash::dump_header& header) -> std::string
+	{
+		switch (header.kind)
+		{
+		case mu::crash::dump_kind::terminate:
+			return "std::terminate";
+		case mu::crash::dump_kind::signal:
+			switch (header.code)
+			{
+			case SIGSEGV:
+				return "signal SIGSEGV";
+			case SIGILL:
+				return "signal SIGILL";
+			case SIGFPE:
+				return "signal SIGFPE";
+			case SIGABRT:
+				return "signal SIGABRT";
+#ifdef SIGBUS
+			case SIGBUS:
+				return "signal SIGBUS";
+#endif
+			default:
+				return "signal " + std::to_string(header.code);
+			}
+		case mu::crash::dump_kind::exception:
+		{
+			char code[16];
+			std::snprintf(code, sizeof(code), "0x%08X", header.code);
+			return std::string("exception ") + code;
+		}
+		}
+		return "unknown";
+	}
+
+	// "function at file:line", or empty if the symbolizer couldn't say.
+	auto symbolize(const std::string& tool, const char* module, const uint64_t address) -> std::string
+	{
+		char hex[32];
+		std::snprintf(hex, sizeof(hex), "0x%llx", static_cast<unsigned long long>(address));
+		const std::string command = tool + " -f -C -e \"" + module + "\" " + hex;
+
+		std::FILE* pipe = popen(command.c_str(), "r");
+		if (pipe == nullptr)
+		{
+			return {};
+		}
+		char	   function[4096] = {};
+		char	   location[4096] = {};
+		const bool ok			  = std::fgets(function, sizeof(function), pipe) != nullptr && std::fgets(location, sizeof(location), pipe) != nullptr;
+		pclose(pipe);
+
+		std::string result;
+		if (ok && function[0] != '?')
+		{
+			result = std::string(function, std::strcspn(function, "\r\n")) + " at " + std::string(location, std::strcspn(location, "\r\n"));
+		}
+		return result;
+	}
+} // namespace details
+
+int main(int argc, char** argv)
+{
+	if (argc != 2 && argc != 3)
+	{
+		std::fprintf(stderr, "usage: %s <dump> [symbolizer]\n", argv[0]);
+		return 2;
+	}
+
+	mu::crash::dump dump;
+	if (!mu::crash::read_dump(argv[1], dump))
+	{
+		std::fprintf(stderr, "%s: not a readable crash dump\n", argv[1]);
+		return 1;
+	}
+	const std::string tool = argc == 3 ? argv[2] : "addr2line";
+
+	char			  when[64] = "?";
+	const std::time_t time	   = static_cast<std::time_t>(dump.header.time);
+	if (const std::tm* utc = std::gmtime(&time))
+	{
+		std::strftime(when, sizeof(when), "%Y-%m-%d %H:%M:%S UTC", utc);
+	}
+	std::printf("%s at %s, fault address 0x%llx\n\n", details::describe(dump.header).c_str(), when, static_cast<unsigned long long>(dump.header.fault_address));
+
+	for (uint32_t i = 0; i < dump.header.frame_count; ++i)
+	{
+		const uint64_t				  address = dump.header.frames[i];
+		const mu::crash::dump_module* module  = dump.find_module(address);
+		if (module == nullptr)
+		{
+			std::printf("#%-2u 0x%016llx\n", i, static_cast<unsigned long long>(address));
+			continue;
+		}
+
+		// Frames are return addresses: look up the call instruction before them, not whatever follows it.
+		const uint64_t	  relative = address - module->bias - 1;
+		const std::string resolved = details::symbolize(tool, module->path, relative);
+		std::printf("#%-2u 0x%016llx %s+0x%llx%s%s\n", i, static_cast<unsigned long long>(address), module->path, static_cast<unsigned long long>(address - module->start),
+					resolved.empty() ? "" : " ", resolved.c_str());
+	}
+
+	std::printf("\nmodules:\n");
+	for (const mu::crash::dump_module& module : dump.modules)
+	{
+		std::string build_id;
+		for (uint32_t b = 0; b < module.build_id_size; ++b)
+		{
+			char hex[3];
+			std::snprintf(hex, sizeof(hex), "%02x", module.build_id[b]);
+			build_id += hex;
+		}
+		std::printf("0x%016llx-0x%016llx %s %s\n", static_cast<unsigned long long>(module.start), static_cast<unsigned long long>(module.end), build_id.empty() ? "-" : build_id.c_str(),
+					module.path);
+	}
+	return 0;
+}
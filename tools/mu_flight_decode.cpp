@@ -0,0 +1,25 @@
+#include <mu_stdlib_flight.h>
+
+#include <cstdio>
+#include <cstdlib>
+
+// Prints what every thread recorded in the last seconds before a run stopped, from the directory it passed to
+// mu::flight::start().
+//
+//     mu_flight_decode flight-1234 [seconds, default 10]
+int main(int argc, char** argv)
+{
+	if (argc != 2 && argc != 3)
+	{
+		std::fprintf(stderr, "usage: %s <directory> [seconds]\n", argv[0]);
+		return 2;
+	}
+
+	const double seconds = argc == 3 ? std::atof(argv[2]) : 10.0;
+	if (!mu::flight::decode(argv[1], mu::time::seconds(seconds), *mu::debug::logger()->stdout_logger()))
+	{
+		std::fprintf(stderr, "%s: not a readable flight recorder directory\n", argv[1]);
+		return 1;
+	}
+	return 0;
+}